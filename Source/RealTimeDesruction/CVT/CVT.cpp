@@ -1,6 +1,10 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "CVT.h"
+#include "Async/TaskGraphInterfaces.h"
+#include <Eigen>
+
+using namespace Eigen;
 
 CVT::CVT()
 {
@@ -18,14 +22,198 @@ void CVT::Lloyd_Algo()
 
     // �� �õ�����Ʈ�� ���� ��Ʈ����Ʈ�� ��ġ�Ҷ����� �ݺ�
     // ���γ��� �� �缳�� -> �� ���� �����߽� ���ϱ� -> �����߽� ���� ���ο� �õ�����Ʈ ����
+    const double StartTime = FPlatformTime::Seconds();
+    int32 Iterations = 0;
     do
     {
+        if (IsCancelled())
+            return;
+
         CVT::CalculateCentroids();
         OldSites = CVT::Sites;
         CVT::Sites = CVT::GenerateNewSite();
         CVT::RefreshRegion();
+        ++Iterations;
         UE_LOG(LogTemp, Log, TEXT("Lloyd Algorithm is successfully executed."))
     } while (not isEqualSites(CVT::Sites, OldSites));
+
+    CVT::LastStats.Iterations = Iterations;
+    CVT::LastStats.TimeMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+    UE_LOG(LogTemp, Log, TEXT("[CVT] Lloyd : %d iterations, %.3f ms"), CVT::LastStats.Iterations, CVT::LastStats.TimeMs);
+}
+
+// 앤더슨 가속 로이드 알고리즘
+// 사이트를 버텍스 인덱스가 아닌 연속 좌표로 두고 고정점 반복 x = G(x) (G: 영역 무게중심)을 가속
+// 가속 스텝이 CVT 에너지를 증가시키면 일반 로이드 스텝으로 되돌리고 히스토리를 초기화
+void CVT::Anderson_Lloyd_Algo(const int32 HistorySize, const int32 MaxIterations, const double Tolerance)
+{
+    const double StartTime = FPlatformTime::Seconds();
+    const int32 NumSites = CVT::Sites.Num();
+    const int32 Dim = NumSites * 3;
+
+    if (NumSites == 0 || CVT::Vertices.Num() == 0)
+        return;
+
+    auto ToVector = [Dim](const TArray<FVector>& Positions)
+        {
+            VectorXd Result(Dim);
+            for (int32 i = 0; i < Positions.Num(); ++i)
+            {
+                Result(3 * i + 0) = Positions[i].X;
+                Result(3 * i + 1) = Positions[i].Y;
+                Result(3 * i + 2) = Positions[i].Z;
+            }
+            return Result;
+        };
+
+    auto ToPositions = [NumSites](const VectorXd& Vector)
+        {
+            TArray<FVector> Result;
+            Result.SetNum(NumSites);
+            for (int32 i = 0; i < NumSites; ++i)
+                Result[i] = FVector(Vector(3 * i + 0), Vector(3 * i + 1), Vector(3 * i + 2));
+            return Result;
+        };
+
+    // 초기 사이트 좌표
+    TArray<FVector> Positions;
+    Positions.SetNum(NumSites);
+    for (int32 i = 0; i < NumSites; ++i)
+        Positions[i] = CVT::Vertices[CVT::Sites[i]];
+
+    TArray<VectorXd> ResidualHistory; // f_k = G(x_k) - x_k
+    TArray<VectorXd> CentroidHistory; // G(x_k)
+    TArray<FVector> Centroids;
+    double LastEnergy = DBL_MAX;
+    bool bAccelerated = false;
+    int32 Iterations = 0;
+
+    while (Iterations < MaxIterations)
+    {
+        if (IsCancelled())
+            return;
+
+        ++Iterations;
+        CVT::RefreshRegionByPositions(Positions);
+        double Energy = CVT::CalculateCentroidsAndEnergy(Positions, Centroids);
+
+        // 가속 스텝이 에너지를 증가시켰다면 직전 로이드 스텝(에너지 비증가 보장)으로 복귀
+        if (bAccelerated && Energy > LastEnergy)
+        {
+            Positions = ToPositions(CentroidHistory.Last());
+            ResidualHistory.Empty();
+            CentroidHistory.Empty();
+            CVT::RefreshRegionByPositions(Positions);
+            Energy = CVT::CalculateCentroidsAndEnergy(Positions, Centroids);
+        }
+        LastEnergy = Energy;
+
+        // 수렴 판정 : 모든 사이트의 이동량이 허용 오차 이하
+        double MaxMove = 0.0;
+        for (int32 i = 0; i < NumSites; ++i)
+            MaxMove = FMath::Max(MaxMove, FVector::Dist(Positions[i], Centroids[i]));
+
+        if (MaxMove < Tolerance)
+        {
+            Positions = Centroids;
+            break;
+        }
+
+        const VectorXd X = ToVector(Positions);
+        const VectorXd G = ToVector(Centroids);
+        const VectorXd F = G - X;
+
+        ResidualHistory.Add(F);
+        CentroidHistory.Add(G);
+        if (ResidualHistory.Num() > HistorySize + 1)
+        {
+            ResidualHistory.RemoveAt(0);
+            CentroidHistory.RemoveAt(0);
+        }
+
+        // x_{k+1} = G(x_k) - dG * gamma,  gamma = argmin || f_k - dF * gamma ||
+        VectorXd Next = G;
+        bAccelerated = false;
+        const int32 M = ResidualHistory.Num() - 1;
+        if (M > 0)
+        {
+            MatrixXd DF(Dim, M);
+            MatrixXd DG(Dim, M);
+            for (int32 j = 0; j < M; ++j)
+            {
+                DF.col(j) = ResidualHistory[j + 1] - ResidualHistory[j];
+                DG.col(j) = CentroidHistory[j + 1] - CentroidHistory[j];
+            }
+
+            const VectorXd Gamma = DF.colPivHouseholderQr().solve(F);
+            if (Gamma.allFinite())
+            {
+                Next = G - DG * Gamma;
+                bAccelerated = true;
+            }
+        }
+        Positions = ToPositions(Next);
+    }
+
+    // 마지막에만 각 영역에서 무게중심에 가장 가까운 버텍스로 스냅
+    CVT::RefreshRegionByPositions(Positions);
+    CVT::BaryCenters = Positions;
+    CVT::Sites = CVT::GenerateNewSite();
+    CVT::RefreshRegion();
+
+    CVT::LastStats.Iterations = Iterations;
+    CVT::LastStats.TimeMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+    UE_LOG(LogTemp, Log, TEXT("[CVT] Anderson : %d iterations, %.3f ms"), CVT::LastStats.Iterations, CVT::LastStats.TimeMs);
+}
+
+// 그래프 거리 기반 로이드 알고리즘
+// 영역 재설정을 유클리드 최근접 대신 그래프 거리 다익스트라로 수행하며,
+// 직전 반복의 거리/레이블 배열을 유지하여 바뀐 사이트의 영역만 다시 전파
+void CVT::Geodesic_Lloyd_Algo(WeightedGraph& Graph, const int& k, const int32 MaxIterations)
+{
+    const double StartTime = FPlatformTime::Seconds();
+    DistanceCalculate DistCalc;
+    DistCalc.CancelFlag = CancelFlag;
+    CVT::DistanceField.Reset();
+
+    int32 Iterations = 0;
+    while (true)
+    {
+        DistCalc.CalculateField(Graph, CVT::Sites, k, CVT::DistanceField);
+        if (IsCancelled())
+            return;
+        ++Iterations;
+
+        TMap<uint32, uint32> SiteToRegion;
+        for (int32 j = 0; j < CVT::Sites.Num(); ++j)
+            SiteToRegion.Add(CVT::Sites[j], j);
+
+        CVT::Region.SetNumUninitialized(CVT::Vertices.Num());
+        ParallelFor(CVT::Vertices.Num(), [&](int32 i)
+            {
+                const uint32* RegionIndex = i < CVT::DistanceField.Label.Num() ? SiteToRegion.Find(CVT::DistanceField.Label[i]) : nullptr;
+                CVT::Region[i] = RegionIndex ? *RegionIndex : MAX_uint32;
+            });
+
+        if (Iterations >= MaxIterations)
+            break;
+
+        CVT::CalculateCentroids();
+        TArray<uint32> NewSites = CVT::GenerateNewSite();
+        if (isEqualSites(NewSites, CVT::Sites))
+            break;
+
+        CVT::Sites = NewSites;
+    }
+
+    CVT::LastStats.Iterations = Iterations;
+    CVT::LastStats.TimeMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+    UE_LOG(LogTemp, Log, TEXT("[CVT] Geodesic : %d iterations, %.3f ms"), CVT::LastStats.Iterations, CVT::LastStats.TimeMs);
+}
+
+TMap<uint32, DistOutEntry> CVT::GetDistanceMap() const
+{
+    return DistanceCalculate::ToDistOut(CVT::DistanceField);
 }
 
 // ����ƽ �޽� ������Ʈ���� ���ؽ� ���� �������� �Լ�
@@ -54,6 +242,17 @@ void CVT::SetVertices(TArray<FVector> new_Vertices)
 
 // ���γ��� �� �缳��
 void CVT::RefreshRegion()
+{
+    TArray<FVector> SitePositions;
+    SitePositions.SetNum(CVT::Sites.Num());
+    for (int32 j = 0; j < CVT::Sites.Num(); ++j)
+        SitePositions[j] = CVT::Vertices[CVT::Sites[j]];
+
+    CVT::RefreshRegionByPositions(SitePositions);
+}
+
+// 연속 좌표 사이트 기준 보로노이 영역 재설정
+void CVT::RefreshRegionByPositions(const TArray<FVector>& SitePositions)
 {
     CVT::Region.Empty();
     CVT::Region.AddUninitialized(CVT::Vertices.Num());
@@ -64,10 +263,9 @@ void CVT::RefreshRegion()
             uint32 ClosestSiteIndex = 0;
             float ClosestDistance = FLT_MAX;
 
-            for (int32 j = 0; j < CVT::Sites.Num(); ++j)
+            for (int32 j = 0; j < SitePositions.Num(); ++j)
             {
-                const FVector& Site = CVT::Vertices[CVT::Sites[j]];
-                float Distance = FVector::DistSquared(Vertex, Site);
+                float Distance = FVector::DistSquared(Vertex, SitePositions[j]);
 
                 if (Distance < ClosestDistance)
                 {
@@ -96,6 +294,10 @@ void CVT::CalculateCentroids()
     // �� ���ؽ� ���� ó��
     ParallelFor(CVT::Vertices.Num(), [&](int32 i)
         {
+            // 어느 사이트에도 도달하지 못한 버텍스 제외
+            if (CVT::Region[i] >= (uint32)CVT::Sites.Num())
+                return;
+
             int32 RegionIndex = CVT::Region[i];
             FVector Vertex = CVT::Vertices[i];
 
@@ -120,6 +322,59 @@ void CVT::CalculateCentroids()
         }
     }
 }
+// 영역별 무게중심과 CVT 에너지(각 버텍스와 사이트 사이 거리 제곱합) 계산
+// 청크별 로컬 합산 후 취합하므로 Lock 불필요. 빈 영역은 현재 사이트 좌표를 유지
+double CVT::CalculateCentroidsAndEnergy(const TArray<FVector>& SitePositions, TArray<FVector>& OutCentroids) const
+{
+    const int32 NumSites = SitePositions.Num();
+    const int32 NumVertices = CVT::Vertices.Num();
+    const int32 NumChunks = FMath::Clamp(FTaskGraphInterface::Get().GetNumWorkerThreads(), 1, FMath::Max(NumVertices, 1));
+    const int32 ChunkSize = FMath::DivideAndRoundUp(NumVertices, NumChunks);
+
+    TArray<TArray<FVector>> ChunkSum;
+    TArray<TArray<uint32>> ChunkCount;
+    TArray<double> ChunkEnergy;
+    ChunkSum.SetNum(NumChunks);
+    ChunkCount.SetNum(NumChunks);
+    ChunkEnergy.Init(0.0, NumChunks);
+
+    ParallelFor(NumChunks, [&](int32 ChunkIndex)
+        {
+            TArray<FVector>& Sum = ChunkSum[ChunkIndex];
+            TArray<uint32>& Count = ChunkCount[ChunkIndex];
+            Sum.Init(FVector::ZeroVector, NumSites);
+            Count.Init(0, NumSites);
+
+            const int32 Begin = ChunkIndex * ChunkSize;
+            const int32 End = FMath::Min(Begin + ChunkSize, NumVertices);
+            for (int32 i = Begin; i < End; ++i)
+            {
+                const uint32 RegionIndex = CVT::Region[i];
+                Sum[RegionIndex] += CVT::Vertices[i];
+                Count[RegionIndex]++;
+                ChunkEnergy[ChunkIndex] += FVector::DistSquared(CVT::Vertices[i], SitePositions[RegionIndex]);
+            }
+        });
+
+    double Energy = 0.0;
+    OutCentroids.SetNum(NumSites);
+    for (int32 j = 0; j < NumSites; ++j)
+    {
+        FVector Sum = FVector::ZeroVector;
+        uint32 Count = 0;
+        for (int32 c = 0; c < NumChunks; ++c)
+        {
+            Sum += ChunkSum[c][j];
+            Count += ChunkCount[c][j];
+        }
+        OutCentroids[j] = Count > 0 ? Sum / Count : SitePositions[j];
+    }
+    for (const double E : ChunkEnergy)
+        Energy += E;
+
+    return Energy;
+}
+
 // �����߽��� �������� ���ο� �õ� ����Ʈ ����
 TArray<uint32> CVT::GenerateNewSite()
 {
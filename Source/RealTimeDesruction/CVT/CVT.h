@@ -7,6 +7,7 @@
 #include "Rendering/PositionVertexBuffer.h"
 #include "Engine/StaticMesh.h"
 #include "Misc/ScopeLock.h"
+#include "../DistanceCalculate/DistanceCalculate.h"
 
 /**
  * ����
@@ -22,7 +23,19 @@
  * CalculateCentroids : �� ���γ��� ���� �����߽� ���
  * GenerateNewSite : �����߽��� �������� ���ο� �õ� ����Ʈ ���� 
  * isEqualSites : �� �õ�����Ʈ TARRAY�� �������� Ȯ��
+ * Anderson_Lloyd_Algo : 앤더슨 가속(Anderson Acceleration)을 적용한 로이드 알고리즘
+ *                       사이트를 연속 좌표로 최적화한 뒤 마지막에만 버텍스로 스냅
+ * Geodesic_Lloyd_Algo : 그래프 거리 기반 보로노이 영역에서 로이드 알고리즘 수행
+ *                       반복 간 거리 필드(DistanceField)를 Warm Start로 재사용하고 마지막 필드를 분할에 그대로 사용
  */
+
+// CVT 수렴 결과 (반복 횟수, 소요 시간)
+struct FCVTStats
+{
+	int32 Iterations = 0;
+	double TimeMs = 0.0;
+};
+
 class REALTIMEDESRUCTION_API CVT
 {
 public:
@@ -31,7 +44,15 @@ public:
 	TArray<uint32> Sites;
 	TArray<FVector> BaryCenters;
 	TArray<uint32> Region;
+	FCVTStats LastStats;
+
+	// 설정되면 반복마다 확인해 취소 시 중단 (결과는 불완전하므로 버려야 함)
+	const std::atomic<bool>* CancelFlag = nullptr;
+	bool IsCancelled() const { return CancelFlag && CancelFlag->load(std::memory_order_relaxed); }
 	void Lloyd_Algo();
+	void Anderson_Lloyd_Algo(const int32 HistorySize = 5, const int32 MaxIterations = 100, const double Tolerance = 1e-2);
+	void Geodesic_Lloyd_Algo(WeightedGraph& Graph, const int& k, const int32 MaxIterations = 50);
+	TMap<uint32, DistOutEntry> GetDistanceMap() const;
 	void GetVertexDataFromStaticMeshComponent(const UStaticMeshComponent* StaticMeshComponent);
 	void SetVertices(TArray<FVector> new_Vertices);
 	void SetVoronoiSites(TArray<uint32> VoronoiSites);
@@ -39,7 +60,11 @@ public:
 
 private:
 	void RefreshRegion();
+	void RefreshRegionByPositions(const TArray<FVector>& SitePositions);
 	void CalculateCentroids();
+	double CalculateCentroidsAndEnergy(const TArray<FVector>& SitePositions, TArray<FVector>& OutCentroids) const;
 	TArray<uint32> GenerateNewSite();
 	bool isEqualSites(TArray<uint32>& Sites1, TArray<uint32>& Sites2);
+
+	FDistanceField DistanceField;
 };
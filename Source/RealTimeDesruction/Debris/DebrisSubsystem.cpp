@@ -0,0 +1,221 @@
+#include "DebrisSubsystem.h"
+#include "../SplitActor/FragmentBudgetSubsystem.h"
+#include "Engine/World.h"
+#include "Engine/StaticMesh.h"
+
+DECLARE_CYCLE_STAT(TEXT("Debris Simulation"), STAT_DebrisSimulation, STATGROUP_Destruction);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Debris Instances"), STAT_DebrisInstances, STATGROUP_Destruction);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Debris Batches"), STAT_DebrisBatches, STATGROUP_Destruction);
+
+bool UDebrisSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UDebrisSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	for (const TSoftObjectPtr<UStaticMesh>& Mesh : DebrisMeshes)
+	{
+		if (UStaticMesh* Loaded = Mesh.LoadSynchronous())
+			LoadedMeshes.Add(Loaded);
+	}
+
+	if (LoadedMeshes.Num() == 0)
+	{
+		if (UStaticMesh* Cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube")))
+			LoadedMeshes.Add(Cube);
+	}
+}
+
+void UDebrisSubsystem::Deinitialize()
+{
+	Batches.Empty();
+	BatchIndices.Empty();
+	LoadedMeshes.Empty();
+	DebrisActor = nullptr;
+	Super::Deinitialize();
+}
+
+TStatId UDebrisSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UDebrisSubsystem, STATGROUP_Tickables);
+}
+
+int32 UDebrisSubsystem::GetNumDebris() const
+{
+	int32 Num = 0;
+	for (const FDebrisBatch& Batch : Batches)
+		Num += Batch.Num();
+	return Num;
+}
+
+UDebrisSubsystem::FDebrisBatch& UDebrisSubsystem::FindOrAddBatch(UStaticMesh* Mesh, UMaterialInterface* Material)
+{
+	const TPair<UStaticMesh*, UMaterialInterface*> Key(Mesh, Material);
+	if (const int32* Index = BatchIndices.Find(Key))
+		return Batches[*Index];
+
+	if (!DebrisActor)
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		DebrisActor = GetWorld()->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+
+		USceneComponent* Root = NewObject<USceneComponent>(DebrisActor);
+		DebrisActor->SetRootComponent(Root);
+		Root->RegisterComponent();
+	}
+
+	auto SetupComponent = [this, Mesh, Material](UInstancedStaticMeshComponent* Component)
+	{
+		Component->SetStaticMesh(Mesh);
+		if (Material)
+			Component->SetMaterial(0, Material);
+		Component->SetMobility(EComponentMobility::Movable);
+		Component->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		Component->SetCastShadow(false);
+		Component->bSupportRemoveAtSwap = true;
+		Component->AttachToComponent(DebrisActor->GetRootComponent(), FAttachmentTransformRules::KeepRelativeTransform);
+		Component->RegisterComponent();
+	};
+
+	UInstancedStaticMeshComponent* Moving = NewObject<UInstancedStaticMeshComponent>(DebrisActor);
+	UHierarchicalInstancedStaticMeshComponent* Resting = NewObject<UHierarchicalInstancedStaticMeshComponent>(DebrisActor);
+	SetupComponent(Moving);
+	SetupComponent(Resting);
+
+	BatchIndices.Add(Key, Batches.Num());
+	FDebrisBatch& Batch = Batches.AddDefaulted_GetRef();
+	Batch.Moving = Moving;
+	Batch.Resting = Resting;
+	return Batch;
+}
+
+bool UDebrisSubsystem::SpawnDebris(const FTransform& Transform, const float Size, const FVector& Velocity, UMaterialInterface* Material, const uint32 TypeHint)
+{
+	if (LoadedMeshes.Num() == 0 || GetNumDebris() >= MaxDebrisInstances)
+		return false;
+
+	UStaticMesh* Mesh = LoadedMeshes[TypeHint % LoadedMeshes.Num()];
+	const float MeshSize = FMath::Max(Mesh->GetBounds().BoxExtent.GetMax() * 2.f, UE_KINDA_SMALL_NUMBER);
+	const float Scale = Size / MeshSize;
+
+	FDebrisBatch& Batch = FindOrAddBatch(Mesh, Material);
+
+	FDebrisInstance Instance;
+	Instance.Location = Transform.GetLocation();
+	Instance.Velocity = Velocity;
+	Instance.Rotation = Transform.GetRotation();
+	Instance.AngularVelocity = FMath::VRand() * FMath::FRandRange(2.f, 8.f);
+	Instance.Scale = FVector(Scale);
+	Instance.GroundZ = -UE_OLD_WORLD_MAX;
+
+	// 바닥은 생성 시 한 번만 찾음
+	FHitResult Hit;
+	const FVector TraceEnd = Instance.Location - FVector(0, 0, 100000);
+	if (GetWorld()->LineTraceSingleByChannel(Hit, Instance.Location, TraceEnd, ECC_WorldStatic))
+		Instance.GroundZ = Hit.ImpactPoint.Z + Size * 0.5f;
+
+	Batch.MovingInstances.Add(Instance);
+	Batch.Moving->AddInstance(Instance.GetTransform(), true);
+	return true;
+}
+
+void UDebrisSubsystem::StepBatch(FDebrisBatch& Batch, const float DeltaTime)
+{
+	const FVector Gravity(0, 0, GetWorld()->GetGravityZ());
+
+	for (FDebrisInstance& Instance : Batch.MovingInstances)
+	{
+		Instance.Age += DeltaTime;
+
+		Instance.Velocity += Gravity * DeltaTime;
+		Instance.Location += Instance.Velocity * DeltaTime;
+
+		const float AngularSpeed = Instance.AngularVelocity.Size();
+		if (AngularSpeed > UE_KINDA_SMALL_NUMBER)
+			Instance.Rotation = FQuat(Instance.AngularVelocity / AngularSpeed, AngularSpeed * DeltaTime) * Instance.Rotation;
+
+		if (Instance.Location.Z < Instance.GroundZ)
+		{
+			Instance.Location.Z = Instance.GroundZ;
+			Instance.Velocity.Z = -Instance.Velocity.Z * Restitution;
+			Instance.Velocity.X *= 1.f - GroundFriction;
+			Instance.Velocity.Y *= 1.f - GroundFriction;
+			Instance.AngularVelocity *= 1.f - GroundFriction;
+
+			// 튀어 오를 속도가 충분하지 않으면 정지
+			if (Instance.Velocity.SizeSquared() < FMath::Square(10.f))
+				Instance.bResting = true;
+		}
+	}
+
+	// 만료되거나 멈춘 파편을 움직이는 배치에서 제거. 뒤에서부터 지워 스왑된 원소를 다시 검사하지 않음
+	TArray<FDebrisInstance> NewResting;
+	for (int32 i = Batch.MovingInstances.Num() - 1; i >= 0; --i)
+	{
+		const FDebrisInstance& Instance = Batch.MovingInstances[i];
+		const bool bExpired = Instance.Age > DebrisLifetime;
+		if (!bExpired && !Instance.bResting)
+			continue;
+
+		if (!bExpired)
+			NewResting.Add(Instance);
+		Batch.Moving->RemoveInstance(i);
+		Batch.MovingInstances.RemoveAtSwap(i, 1, EAllowShrinking::No);
+	}
+
+	if (Batch.MovingInstances.Num() > 0)
+	{
+		TArray<FTransform> Transforms;
+		Transforms.Reserve(Batch.MovingInstances.Num());
+		for (const FDebrisInstance& Instance : Batch.MovingInstances)
+			Transforms.Add(Instance.GetTransform());
+
+		Batch.Moving->BatchUpdateInstancesTransforms(0, Transforms, true, true, false);
+	}
+
+	// 멈춘 파편은 변환이 바뀌지 않으므로 추가와 만료 때만 HISM 갱신
+	for (int32 i = Batch.RestingInstances.Num() - 1; i >= 0; --i)
+	{
+		FDebrisInstance& Instance = Batch.RestingInstances[i];
+		Instance.Age += DeltaTime;
+		if (Instance.Age > DebrisLifetime)
+		{
+			Batch.Resting->RemoveInstance(i);
+			Batch.RestingInstances.RemoveAtSwap(i, 1, EAllowShrinking::No);
+		}
+	}
+
+	// 만료 제거가 끝난 뒤 추가해야 두 배열의 인스턴스 순서가 어긋나지 않음
+	if (NewResting.Num() > 0)
+	{
+		TArray<FTransform> Transforms;
+		Transforms.Reserve(NewResting.Num());
+		for (const FDebrisInstance& Instance : NewResting)
+			Transforms.Add(Instance.GetTransform());
+
+		Batch.RestingInstances.Append(MoveTemp(NewResting));
+		Batch.Resting->AddInstances(Transforms, false, true);
+	}
+}
+
+void UDebrisSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_DebrisSimulation);
+
+	int32 NumInstances = 0;
+	for (FDebrisBatch& Batch : Batches)
+	{
+		if (!IsValid(Batch.Moving) || !IsValid(Batch.Resting) || Batch.Num() == 0)
+			continue;
+
+		StepBatch(Batch, DeltaTime);
+		NumInstances += Batch.Num();
+	}
+
+	SET_DWORD_STAT(STAT_DebrisInstances, NumInstances);
+	SET_DWORD_STAT(STAT_DebrisBatches, Batches.Num());
+}
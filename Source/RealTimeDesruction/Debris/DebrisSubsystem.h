@@ -0,0 +1,92 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "DebrisSubsystem.generated.h"
+
+/**
+ * 작은 파편 렌더링
+ *
+ * 크기가 작은 조각은 고유 메쉬 대신 공용 청크 메쉬의 인스턴스로 그림
+ * (청크 메쉬, 머티리얼) 쌍마다 컴포넌트를 두므로 드로우 콜은 파편 수가 아니라 파편 종류 수에 비례
+ * 움직이는 파편은 매 틱 변환을 갱신하므로 클러스터 트리가 없는 ISM에, 멈춘 파편은 컬링용 HISM에 둠
+ * 물리는 중력 적분과 생성 시점에 찾은 바닥 높이에 대한 반발만 처리하는 가벼운 시뮬레이션
+ */
+UCLASS(config = Game)
+class REALTIMEDESRUCTION_API UDebrisSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Size: 파편 한 변의 길이(cm). TypeHint로 청크 메쉬 선택. 예산 초과 시 false
+	bool SpawnDebris(const FTransform& Transform, const float Size, const FVector& Velocity, UMaterialInterface* Material, const uint32 TypeHint);
+
+	UFUNCTION(BlueprintPure, Category = "Destruction")
+	int32 GetNumDebris() const;
+
+	// 파편에 쓰는 공용 청크 메쉬. 비어 있으면 엔진 기본 큐브 사용
+	UPROPERTY(config, EditAnywhere, Category = "Destruction")
+	TArray<TSoftObjectPtr<UStaticMesh>> DebrisMeshes;
+
+	// 파편이 사라지기까지의 시간(초)
+	UPROPERTY(config, EditAnywhere, BlueprintReadWrite, Category = "Destruction", meta = (ClampMin = "0.1"))
+	float DebrisLifetime = 8.f;
+
+	// 동시에 존재하는 파편 인스턴스의 최대 수
+	UPROPERTY(config, EditAnywhere, BlueprintReadWrite, Category = "Destruction", meta = (ClampMin = "0"))
+	int32 MaxDebrisInstances = 4096;
+
+	// 바닥 충돌 시 수직 속도 보존 비율과 수평 속도 감쇠 비율
+	UPROPERTY(config, EditAnywhere, BlueprintReadWrite, Category = "Destruction", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float Restitution = 0.3f;
+
+	UPROPERTY(config, EditAnywhere, BlueprintReadWrite, Category = "Destruction", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float GroundFriction = 0.5f;
+
+private:
+	struct FDebrisInstance
+	{
+		FVector Location;
+		FVector Velocity;
+		FQuat Rotation;
+		FVector AngularVelocity;	// rad/s
+		FVector Scale;
+		double GroundZ;				// 바닥 높이 (파편 중심 기준)
+		float Age = 0.f;
+		bool bResting = false;
+
+		FTransform GetTransform() const { return FTransform(Rotation, Location, Scale); }
+	};
+
+	// 인스턴스 배열과 컴포넌트 인스턴스 순서가 같도록 양쪽 모두 RemoveAtSwap으로 제거
+	struct FDebrisBatch
+	{
+		UInstancedStaticMeshComponent* Moving = nullptr;
+		UHierarchicalInstancedStaticMeshComponent* Resting = nullptr;
+		TArray<FDebrisInstance> MovingInstances;
+		TArray<FDebrisInstance> RestingInstances;
+
+		int32 Num() const { return MovingInstances.Num() + RestingInstances.Num(); }
+	};
+
+	FDebrisBatch& FindOrAddBatch(UStaticMesh* Mesh, UMaterialInterface* Material);
+	void StepBatch(FDebrisBatch& Batch, const float DeltaTime);
+
+	// 인스턴스 컴포넌트를 소유하는 액터
+	UPROPERTY()
+	TObjectPtr<AActor> DebrisActor;
+
+	UPROPERTY()
+	TArray<TObjectPtr<UStaticMesh>> LoadedMeshes;
+
+	TMap<TPair<UStaticMesh*, UMaterialInterface*>, int32> BatchIndices;
+	TArray<FDebrisBatch> Batches;
+};
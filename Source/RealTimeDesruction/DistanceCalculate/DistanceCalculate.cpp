@@ -1,7 +1,5 @@
 #include "DistanceCalculate.h"
 
-std::shared_mutex PredMutex;
-
 constexpr uint32 MaxUInt32 = std::numeric_limits<uint32>::max();
 constexpr double MaxDouble = std::numeric_limits<double>::infinity();
 
@@ -46,8 +44,12 @@ TMap<uint32, DistOutEntry> DistanceCalculate::Calculate(WeightedGraph& graph, co
 
                 // �켱 ���� ť�� ���� ��� ����
                 Q.emplace(0.0, Sources[i]);
+                uint32 NumPopped = 0;
                 while (!Q.empty())
                 {
+                    if (++NumPopped % CancelCheckInterval == 0 && IsCancelled())
+                        break;
+
                     PII Current = Q.top();
                     Q.pop();
 
@@ -96,6 +98,118 @@ TMap<uint32, DistOutEntry> DistanceCalculate::Calculate(WeightedGraph& graph, co
     return Result;
 }
 
+void DistanceCalculate::CalculateField(WeightedGraph& graph, const TArray<uint32>& Sources, const int& k, FDistanceField& Field)
+{
+    const TArray<uint32> Vertices = graph.Vertices();
+    uint32 NumVertices = 0;
+    for (const uint32 Vertex : Vertices)
+        NumVertices = FMath::Max(NumVertices, Vertex + 1);
+
+    using PII = TPair<double, uint32>;
+    std::priority_queue<PII, std::vector<PII>, std::greater<PII>> Q;
+
+    const bool bWarmStart = Field.Dist.Num() == (int32)NumVertices && Field.Sources.Num() > 0;
+
+    if (!bWarmStart)
+    {
+        Field.Dist.Init(MaxDouble, NumVertices);
+        Field.Label.Init(MaxUInt32, NumVertices);
+        Field.Pred.SetNumUninitialized(NumVertices);
+        Field.PredVector.Init(FVector::ZeroVector, NumVertices);
+        for (uint32 i = 0; i < NumVertices; ++i)
+            Field.Pred[i] = i;
+    }
+    else
+    {
+        // 사라진 Source가 차지하던 영역 무효화
+        TSet<uint32> RemovedSources(Field.Sources);
+        for (const uint32 Src : Sources)
+            RemovedSources.Remove(Src);
+
+        TArray<uint32> Invalidated;
+        if (RemovedSources.Num() > 0)
+        {
+            for (uint32 i = 0; i < NumVertices; ++i)
+            {
+                if (Field.Label[i] != MaxUInt32 && RemovedSources.Contains(Field.Label[i]))
+                {
+                    Field.Dist[i] = MaxDouble;
+                    Field.Label[i] = MaxUInt32;
+                    Field.Pred[i] = i;
+                    Invalidated.Add(i);
+                }
+            }
+        }
+
+        // 무효화된 영역과 맞닿은 유효 버텍스에서 다시 전파
+        for (const uint32 u : Invalidated)
+        {
+            const TArray<Link>* Links = graph.findLinks(u);
+            if (!Links)
+                continue;
+
+            for (const Link& link : *Links)
+            {
+                const uint32 v = link.VertexIndex;
+                if (Field.Label[v] != MaxUInt32)
+                    Q.emplace(Field.Dist[v], v);
+            }
+        }
+    }
+
+    for (const uint32 Src : Sources)
+    {
+        Field.Dist[Src] = 0.0;
+        Field.Label[Src] = Src;
+        Field.Pred[Src] = Src;
+        Q.emplace(0.0, Src);
+    }
+    Field.Sources = Sources;
+
+    uint32 NumPopped = 0;
+    while (!Q.empty())
+    {
+        if (++NumPopped % CancelCheckInterval == 0 && IsCancelled())
+            return;
+
+        auto [curDist, u] = Q.top();
+        Q.pop();
+
+        if (curDist > Field.Dist[u])
+            continue;
+
+        const TArray<Link>* Links = graph.findLinks(u);
+        if (!Links)
+            continue;
+
+        for (const Link& link : *Links)
+        {
+            const uint32 v = link.VertexIndex;
+            const double NewDist = recalculateDistance(link, u, Field.Dist[u], Field, k);
+
+            if (NewDist < Field.Dist[v])
+            {
+                Field.Dist[v] = NewDist;
+                Field.Label[v] = Field.Label[u];
+                Field.Pred[v] = u;
+                Field.PredVector[v] = link.linkVector;
+                Q.emplace(NewDist, v);
+            }
+        }
+    }
+}
+
+TMap<uint32, DistOutEntry> DistanceCalculate::ToDistOut(const FDistanceField& Field)
+{
+    TMap<uint32, DistOutEntry> Result;
+    Result.Reserve(Field.Dist.Num());
+    for (int32 i = 0; i < Field.Dist.Num(); ++i)
+        if (Field.Dist[i] != MaxDouble)
+            Result.Add((uint32)i, { Field.Dist[i], Field.Label[i] });
+
+    return Result;
+}
+
 // ���� ���͸� ����� �Ÿ� ���
 double DistanceCalculate::recalculateDistance(WeightedGraph& graph, const uint32& u, const uint32& v, const double& Dist, const TMap<uint32, TUniquePtr<std::atomic<uint32>>>& Pred, const int& k)
 {
@@ -145,6 +259,42 @@ double DistanceCalculate::recalculateDistance(WeightedGraph& graph, const uint32
     return Dist + correctedDist;
 }
 
+// 거리 필드(평탄 배열) 버전. 단일 스레드에서만 호출되므로 Lock 불필요
+// u → v 에지는 호출자가 넘기고, 그 이전 경로는 PredVector에 저장된 에지 벡터로 추적 (그래프 탐색 없음)
+double DistanceCalculate::recalculateDistance(const Link& Edge, const uint32& u, const double& Dist, const FDistanceField& Field, const int& k)
+{
+    double correctedDist = Edge.linkVector.Size() + Edge.weight;
+    TArray<FVector, TInlineAllocator<8>> totalVector;
+
+    if (k > 0)
+        totalVector.Add(Edge.linkVector);
+
+    uint32 current = u;
+    for (int32 i = 1; i < k; ++i)
+    {
+        const uint32 pred_i = Field.Pred[current];
+        if (pred_i == current) break;
+
+        totalVector.Add(Field.PredVector[current]);
+        current = pred_i;
+    }
+
+    if (totalVector.Num() > 1)
+    {
+        FVector prevDirection = totalVector[0].GetSafeNormal();
+
+        for (int32 i = 1; i < totalVector.Num(); ++i)
+        {
+            const FVector direction = totalVector[i].GetSafeNormal();
+            double angle = 1.0 - FVector::DotProduct(direction, prevDirection);
+            correctedDist += angle;
+            prevDirection = direction;
+        }
+    }
+
+    return Dist + correctedDist;
+}
+
 // ���� ��� Vertex Ž��
 uint32 DistanceCalculate::getPredecessor(const uint32& vertex, const TMap<uint32, TUniquePtr<std::atomic<uint32>>>& Pred)
 {
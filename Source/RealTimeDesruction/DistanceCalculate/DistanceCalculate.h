@@ -16,6 +16,25 @@ struct DistOutEntry
 	uint32 Source;
 };
 
+// 버텍스 인덱스로 직접 접근하는 거리 필드. 반복 계산 시 이전 결과를 Warm Start로 재사용
+struct FDistanceField
+{
+	TArray<double> Dist;	// 가장 가까운 Source까지의 거리
+	TArray<uint32> Label;	// 가장 가까운 Source 버텍스
+	TArray<uint32> Pred;	// 최단 경로 상의 직전 버텍스
+	TArray<FVector> PredVector;	// Pred → 버텍스 에지 벡터. 경로 추적 시 에지를 다시 찾지 않도록 보관
+	TArray<uint32> Sources;	// 이 필드를 계산한 Source 목록
+
+	void Reset()
+	{
+		Dist.Empty();
+		Label.Empty();
+		Pred.Empty();
+		PredVector.Empty();
+		Sources.Empty();
+	}
+};
+
 class REALTIMEDESRUCTION_API DistanceCalculate
 {
 public:
@@ -23,9 +42,24 @@ public:
 
 	TMap<uint32, DistOutEntry> Calculate(WeightedGraph& graph, const TArray<uint32>& Sources, const int& k);
 
+	// 다중 Source 다익스트라. Field에 이전 결과가 있으면 사라진 Source의 영역만 무효화하고 다시 전파
+	void CalculateField(WeightedGraph& graph, const TArray<uint32>& Sources, const int& k, FDistanceField& Field);
+
+	static TMap<uint32, DistOutEntry> ToDistOut(const FDistanceField& Field);
+
+	// 설정되면 다익스트라 루프가 CancelCheckInterval번 꺼낼 때마다 확인해 취소 시 중단 (결과는 불완전)
+	const std::atomic<bool>* CancelFlag = nullptr;
+	bool IsCancelled() const { return CancelFlag && CancelFlag->load(std::memory_order_relaxed); }
+
 	~DistanceCalculate() = default;
 
 private:
+	static constexpr uint32 CancelCheckInterval = 1024;
+
 	double recalculateDistance(WeightedGraph& graph, const uint32& u, const uint32& v, const double& Dist, const TMap<uint32, TUniquePtr<std::atomic<uint32>>>& Pred, const int& k);
+	double recalculateDistance(const Link& Edge, const uint32& u, const double& Dist, const FDistanceField& Field, const int& k);
 	uint32 getPredecessor(const uint32& vertex, const TMap<uint32, TUniquePtr<std::atomic<uint32>>>& Pred);
+
+	// Calculate 한 번의 선행 정점 갱신과 경로 추적을 동기화. 인스턴스마다 따로 두어 다른 액터의 계산과 경합하지 않음
+	std::shared_mutex PredMutex;
 };
\ No newline at end of file
@@ -6,12 +6,30 @@
 #include "FTetWildWrapper.h"
 #include "Engine/StaticMesh.h"
 #include "HAL/PlatformTLS.h"
+#include "Math/VectorRegister.h"
 #include <atomic>
 
 #include "FTetWildWrapper.h"
 
 using namespace Eigen;
 
+// 형상함수(Shape Function) 미분 행렬 (상수)
+// 사면체의 4개 형상함수: N1 = 1-ξ-η-ζ, N2 = ξ, N3 = η, N4 = ζ
+static const Matrix<float, 4, 3>& ShapeFunctionDiffMatrix()
+{
+    static const Matrix<float, 4, 3> M = []()
+    {
+        Matrix<float, 4, 3> Result;
+        Result.setZero();
+        Result(0, 0) = -1; Result(0, 1) = -1; Result(0, 2) = -1;  // ∂N1/∂ξ, ∂N1/∂η, ∂N1/∂ζ
+        Result(1, 0) =  1;                                          // ∂N2/∂ξ = 1
+        Result(2, 1) =  1;                                          // ∂N3/∂η = 1
+        Result(3, 2) =  1;                                          // ∂N4/∂ζ = 1
+        return Result;
+    }();
+    return M;
+}
+
 UFEMCalculateComponent::UFEMCalculateComponent()
 {
 	PrimaryComponentTick.bCanEverTick = false;
@@ -86,8 +104,11 @@ void UFEMCalculateComponent::InitializeTetMesh()
         UFEMCalculateComponent* FEMComponent = OnwerActor->FindComponentByClass<UFEMCalculateComponent>();
         SetUndeformedPositions();
         KMatrix();
+        PrecomputeStrainKernelData();
 
         GenerateGraphFromTets();
+        BuildTetEdgeTable();
+        BuildRenderToTetVertexMap(Verts);
 
         // 성능 벤치마크 실행 (초기화 완료 후)
         if (bEnableProfiling)
@@ -102,6 +123,94 @@ void UFEMCalculateComponent::InitializeTetMesh()
 }
 
 
+void UFEMCalculateComponent::BuildTetEdgeTable()
+{
+    static constexpr int32 EdgeEnds[6][2] = { { 0, 1 }, { 0, 2 }, { 0, 3 }, { 1, 2 }, { 1, 3 }, { 2, 3 } };
+
+    TMap<uint64, int32> EdgeMap;
+    EdgeMap.Reserve(Tets.Num() * 2);
+    TetEdges.Reset();
+    TetEdgeIndices.SetNumUninitialized(Tets.Num() * 6);
+
+    for (int32 t = 0; t < Tets.Num(); ++t)
+    {
+        const FIntVector4& Tet = Tets[t];
+        for (int32 e = 0; e < 6; ++e)
+        {
+            const int32 A = FMath::Min(Tet[EdgeEnds[e][0]], Tet[EdgeEnds[e][1]]);
+            const int32 B = FMath::Max(Tet[EdgeEnds[e][0]], Tet[EdgeEnds[e][1]]);
+            const uint64 Key = ((uint64)(uint32)A << 32) | (uint32)B;
+
+            int32& Index = EdgeMap.FindOrAdd(Key, INDEX_NONE);
+            if (Index == INDEX_NONE)
+            {
+                Index = TetEdges.Emplace(A, B);
+            }
+            TetEdgeIndices[6 * t + e] = Index;
+        }
+    }
+}
+
+void UFEMCalculateComponent::BuildRenderToTetVertexMap(const TArray<FVector>& RenderVertices)
+{
+    double StartTime = FPlatformTime::Seconds();
+
+    // 격자 크기가 허용 오차보다 크므로 일치하는 정점은 항상 주변 27칸 안에 있음
+    constexpr double CellSize = 10.0 * KINDA_SMALL_NUMBER;
+    auto ToCell = [](const FVector& Position)
+    {
+        return FIntVector(
+            FMath::FloorToInt32(Position.X / CellSize),
+            FMath::FloorToInt32(Position.Y / CellSize),
+            FMath::FloorToInt32(Position.Z / CellSize));
+    };
+
+    TMap<FIntVector, TArray<int32, TInlineAllocator<2>>> Grid;
+    Grid.Reserve(TetMeshVertices.Num());
+    for (int32 j = 0; j < TetMeshVertices.Num(); ++j)
+    {
+        Grid.FindOrAdd(ToCell(TetMeshVertices[j])).Add(j);
+    }
+
+    RenderToTetVertex.SetNumUninitialized(RenderVertices.Num());
+    ParallelFor(RenderVertices.Num(), [&](int32 i)
+    {
+        const FVector& Position = RenderVertices[i];
+        const FIntVector Cell = ToCell(Position);
+
+        // 여러 정점이 일치하면 기존 선형 탐색과 같이 가장 작은 인덱스 선택
+        int32 Match = INDEX_NONE;
+        for (int32 dx = -1; dx <= 1; ++dx)
+        {
+            for (int32 dy = -1; dy <= 1; ++dy)
+            {
+                for (int32 dz = -1; dz <= 1; ++dz)
+                {
+                    const auto* Bucket = Grid.Find(Cell + FIntVector(dx, dy, dz));
+                    if (!Bucket)
+                    {
+                        continue;
+                    }
+                    for (int32 j : *Bucket)
+                    {
+                        if ((Match == INDEX_NONE || j < Match) && (TetMeshVertices[j] - Position).IsNearlyZero())
+                        {
+                            Match = j;
+                        }
+                    }
+                }
+            }
+        }
+        RenderToTetVertex[i] = Match;
+    });
+
+    if (bEnableProfiling)
+    {
+        UE_LOG(LogTemp, Log, TEXT("[FEM Profiling] RenderToTetVertex: %.3f ms (%d render vertices)"),
+            (FPlatformTime::Seconds() - StartTime) * 1000.0, RenderVertices.Num());
+    }
+}
+
 void UFEMCalculateComponent::GenerateGraphFromTets()
 {
     // 모든 정점을 그래프에 추가
@@ -129,6 +238,13 @@ void UFEMCalculateComponent::GenerateGraphFromTets()
 
 float UFEMCalculateComponent::CalculateEnergyAtTatUsingFEM(const FVector& Velocity, const FVector& NextTickVelocity, const float Mass, const FVector& HitPoint)
 {
+    // 진행 중인 파괴가 Graph와 충격 정보를 사용 중. 원본은 곧 조각으로 바뀌므로 충격을 버림
+    if (bDestructionLocked)
+    {
+        UE_LOG(LogTemp, Verbose, TEXT("Impact ignored while destruction is in progress."));
+        return 0.f;
+    }
+
     // 1. 충돌 지점에서 가장 가까운 사면체와 삼각형 면 찾기
     int32 ExcludedIndex = 0;
     FInt32Vector4 ClosestResult = GetClosestTriangleAndTet(HitPoint, ExcludedIndex);
@@ -435,6 +551,8 @@ Matrix<float, 9, 1> UFEMCalculateComponent::CalculateImpactForceMatrix(const FVe
     const FVector DeltaVelocity = NextTickVelocity - InitialVelocity;
     // 충격력 계산: F = m * Δv / Δt
     const FVector ImpactForce = (Mass * DeltaVelocity) / DeltaTime;
+    CurrentImpactForce = ImpactForce;
+    CurrentHitPoint = HitPoint;
 
     Matrix<float, 9, 1> ImpactForceMatrix;
     ImpactForceMatrix.setZero();
@@ -546,21 +664,8 @@ Matrix<float, 12, 12> UFEMCalculateComponent::ComputeKElementForTet(int32 TetInd
     // Jacobian 행렬 계산 (로컬 → 전역 좌표 변환)
     const Matrix<float, 3, 3> Jaco = Jacobian(Demention);
 
-    // 형상함수(Shape Function) 미분 행렬 구성 (상수)
-    // 사면체의 4개 형상함수: N1 = 1-ξ-η-ζ, N2 = ξ, N3 = η, N4 = ζ
-    static const Matrix<float, 4, 3> ShapeFunctionDiffMatrix = []()
-    {
-        Matrix<float, 4, 3> M;
-        M.setZero();
-        M(0, 0) = -1; M(0, 1) = -1; M(0, 2) = -1;  // ∂N1/∂ξ, ∂N1/∂η, ∂N1/∂ζ
-        M(1, 0) =  1;                                 // ∂N2/∂ξ = 1
-        M(2, 1) =  1;                                 // ∂N3/∂η = 1
-        M(3, 2) =  1;                                 // ∂N4/∂ζ = 1
-        return M;
-    }();
-
     // 전역 좌표계에 대한 형상함수 미분: ∂N/∂x = ∂N/∂ξ * J^-1
-    const Matrix<float, 4, 3> Result = ShapeFunctionDiffMatrix * Jaco.inverse();
+    const Matrix<float, 4, 3> Result = ShapeFunctionDiffMatrix() * Jaco.inverse();
     const float Volume = GetTetVolume(Jaco);
 
     // K = V * B^T * E * B
@@ -569,6 +674,241 @@ Matrix<float, 12, 12> UFEMCalculateComponent::ComputeKElementForTet(int32 TetInd
     return Volume * MatrixB.transpose() * MatrixE * MatrixB;
 }
 
+void UFEMCalculateComponent::PrecomputeStrainKernelData()
+{
+    const int32 NumTets = Tets.Num();
+    const int32 NumVertices = TetMeshVertices.Num();
+    NumPaddedTets = Align(NumTets, 4);
+
+    // 패딩 사면체는 부피 0이므로 에너지 0
+    TetShapeGradients.Init(0.f, 12 * NumPaddedTets);
+    TetRestVolumes.Init(0.f, NumPaddedTets);
+
+    ParallelFor(NumTets, [&](int32 t)
+    {
+        const FIntVector4& Tet = Tets[t];
+        Matrix<float, 3, 4> Demention;
+        for (int vtx = 0; vtx < 4; vtx++)
+        {
+            for (int dim = 0; dim < 3; dim++)
+            {
+                // cm → m, 변위장과 단위를 맞춤
+                Demention(dim, vtx) = UndeformedPositions[3 * Tet[vtx] + dim] / 100;
+            }
+        }
+
+        const Matrix<float, 3, 3> Jaco = Jacobian(Demention);
+        const Matrix<float, 4, 3> Grad = ShapeFunctionDiffMatrix() * Jaco.inverse();
+
+        for (int i = 0; i < 4; i++)
+        {
+            for (int b = 0; b < 3; b++)
+            {
+                TetShapeGradients[(i * 3 + b) * NumPaddedTets + t] = Grad(i, b);
+            }
+        }
+        TetRestVolumes[t] = FMath::Abs(GetTetVolume(Jaco));
+    });
+
+    // 평균 사면체 크기를 Kelvin 해의 최소 반경으로 사용
+    double TotalVolume = 0.0;
+    for (int32 t = 0; t < NumTets; ++t)
+    {
+        TotalVolume += TetRestVolumes[t];
+    }
+    if (NumTets > 0)
+    {
+        KelvinCoreRadius = FMath::Max((float)FMath::Pow(6.0 * TotalVolume / NumTets, 1.0 / 3.0), KINDA_SMALL_NUMBER);
+    }
+
+    // 정점 → 사면체 CSR 구성
+    VertexTetOffsets.Init(0, NumVertices + 1);
+    for (const FIntVector4& Tet : Tets)
+    {
+        for (int i = 0; i < 4; i++)
+        {
+            VertexTetOffsets[Tet[i] + 1]++;
+        }
+    }
+    for (int32 v = 0; v < NumVertices; ++v)
+    {
+        VertexTetOffsets[v + 1] += VertexTetOffsets[v];
+    }
+
+    TArray<int32> Cursor(VertexTetOffsets.GetData(), NumVertices);
+    VertexTetIndices.SetNumUninitialized(VertexTetOffsets[NumVertices]);
+    for (int32 t = 0; t < NumTets; ++t)
+    {
+        for (int i = 0; i < 4; i++)
+        {
+            VertexTetIndices[Cursor[Tets[t][i]]++] = t;
+        }
+    }
+}
+
+void UFEMCalculateComponent::ComputeTetStrainEnergies(const TArray<FVector3f>& Displacement, TArray<float>& OutTetEnergy) const
+{
+    const int32 NumTets = Tets.Num();
+    const int32 NumBlocks = NumPaddedTets / 4;
+    OutTetEnergy.SetNumUninitialized(NumPaddedTets);
+
+    const VectorRegister4Float VMu = VectorSetFloat1(Mu);
+    const VectorRegister4Float VHalfLambda = VectorSetFloat1(0.5f * Lambda);
+    const VectorRegister4Float VHalf = VectorSetFloat1(0.5f);
+    const VectorRegister4Float VTwo = VectorSetFloat1(2.f);
+
+    // 각 블록은 사면체 4개를 SIMD 레인 4개에 배치, 블록마다 출력 범위가 겹치지 않으므로 동기화 불필요
+    ParallelFor(NumBlocks, [&](int32 Block)
+    {
+        const int32 T0 = Block * 4;
+
+        // 변위 수집: U[i * 3 + a][Lane] = 사면체 (T0 + Lane)의 i번째 정점 변위의 a 성분
+        alignas(16) float U[12][4];
+        for (int32 Lane = 0; Lane < 4; ++Lane)
+        {
+            const int32 t = T0 + Lane;
+            for (int i = 0; i < 4; i++)
+            {
+                const FVector3f D = t < NumTets ? Displacement[Tets[t][i]] : FVector3f::ZeroVector;
+                U[i * 3 + 0][Lane] = D.X;
+                U[i * 3 + 1][Lane] = D.Y;
+                U[i * 3 + 2][Lane] = D.Z;
+            }
+        }
+
+        // 변위 구배: H(a, b) = Σ_i u_i[a] * ∂N_i/∂x_b
+        VectorRegister4Float H[3][3];
+        for (int a = 0; a < 3; a++)
+        {
+            for (int b = 0; b < 3; b++)
+            {
+                H[a][b] = VectorZeroFloat();
+            }
+        }
+
+        for (int i = 0; i < 4; i++)
+        {
+            VectorRegister4Float G[3];
+            VectorRegister4Float Ui[3];
+            for (int c = 0; c < 3; c++)
+            {
+                G[c] = VectorLoad(&TetShapeGradients[(i * 3 + c) * NumPaddedTets + T0]);
+                Ui[c] = VectorLoadAligned(U[i * 3 + c]);
+            }
+
+            for (int a = 0; a < 3; a++)
+            {
+                for (int b = 0; b < 3; b++)
+                {
+                    H[a][b] = VectorMultiplyAdd(Ui[a], G[b], H[a][b]);
+                }
+            }
+        }
+
+        // 변형률 텐서: ε = (H + H^T) / 2
+        const VectorRegister4Float E01 = VectorMultiply(VHalf, VectorAdd(H[0][1], H[1][0]));
+        const VectorRegister4Float E02 = VectorMultiply(VHalf, VectorAdd(H[0][2], H[2][0]));
+        const VectorRegister4Float E12 = VectorMultiply(VHalf, VectorAdd(H[1][2], H[2][1]));
+
+        // ε:ε = Σ εaa² + 2 Σ(a<b) εab²
+        VectorRegister4Float DoubleDot = VectorMultiply(H[0][0], H[0][0]);
+        DoubleDot = VectorMultiplyAdd(H[1][1], H[1][1], DoubleDot);
+        DoubleDot = VectorMultiplyAdd(H[2][2], H[2][2], DoubleDot);
+        VectorRegister4Float OffDiagonal = VectorMultiply(E01, E01);
+        OffDiagonal = VectorMultiplyAdd(E02, E02, OffDiagonal);
+        OffDiagonal = VectorMultiplyAdd(E12, E12, OffDiagonal);
+        DoubleDot = VectorMultiplyAdd(VTwo, OffDiagonal, DoubleDot);
+
+        // tr(ε)
+        const VectorRegister4Float Trace = VectorAdd(VectorAdd(H[0][0], H[1][1]), H[2][2]);
+
+        // ψ = μ(ε:ε) + (λ/2)(tr(ε))², E = ψV
+        const VectorRegister4Float EnergyDensity = VectorMultiplyAdd(VMu, DoubleDot, VectorMultiply(VHalfLambda, VectorMultiply(Trace, Trace)));
+        const VectorRegister4Float Energy = VectorMultiply(EnergyDensity, VectorLoad(&TetRestVolumes[T0]));
+
+        VectorStore(Energy, &OutTetEnergy[T0]);
+    });
+}
+
+void UFEMCalculateComponent::BuildKelvinDisplacementField(const FFEMImpact& Impact, TArray<FVector3f>& OutDisplacement) const
+{
+    const int32 NumVertices = TetMeshVertices.Num();
+    OutDisplacement.SetNumUninitialized(NumVertices);
+
+    // 푸아송 비: ν = λ / (2(λ + μ))
+    const float Nu = Lambda / (2.f * (Lambda + Mu));
+    const float Coefficient = 1.f / (16.f * PI * Mu * (1.f - Nu));
+    const FVector3f Force = (FVector3f)Impact.ImpactForce;
+
+    ParallelFor(NumVertices, [&](int32 v)
+    {
+        // cm → m
+        FVector3f R = (FVector3f)(TetMeshVertices[v] - Impact.HitPoint) / 100;
+        const float Length = FMath::Max(R.Size(), KelvinCoreRadius);
+        OutDisplacement[v] = Coefficient / Length * ((3.f - 4.f * Nu) * Force + R * (FVector3f::DotProduct(R, Force) / (Length * Length)));
+    });
+}
+
+void UFEMCalculateComponent::UpdateGraphWeightFromDisplacement(const TArray<FVector3f>& Displacement)
+{
+    const int32 NumVertices = TetMeshVertices.Num();
+    if (Displacement.Num() != NumVertices || VertexTetOffsets.Num() != NumVertices + 1)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Strain energy kernel is not ready."));
+        return;
+    }
+
+    double StartTime = FPlatformTime::Seconds();
+
+    TArray<float> TetEnergy;
+    ComputeTetStrainEnergies(Displacement, TetEnergy);
+
+    // 정점: 인접 사면체 에너지의 1/4 합. 정점마다 자기 값만 모으므로 Atomic 불필요
+    VertexStrainEnergy.SetNumUninitialized(NumVertices);
+    ParallelFor(NumVertices, [&](int32 v)
+    {
+        float Sum = 0.f;
+        for (int32 k = VertexTetOffsets[v]; k < VertexTetOffsets[v + 1]; ++k)
+        {
+            Sum += TetEnergy[VertexTetIndices[k]];
+        }
+        VertexStrainEnergy[v] = 0.25f * Sum;
+    });
+
+    // 에지: 각 정점이 자기 인접 리스트만 갱신
+    ParallelFor(NumVertices, [&](int32 v)
+    {
+        TArray<Link>* Links = Graph.findLinks(v);
+        if (!Links)
+        {
+            return;
+        }
+        for (Link& link : *Links)
+        {
+            link.weight = StrainEnergyWeightScale * 0.5f * (VertexStrainEnergy[v] + VertexStrainEnergy[link.VertexIndex]);
+        }
+    });
+
+    StrainEnergyTimeMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+    if (bEnableProfiling)
+    {
+        UE_LOG(LogTemp, Log, TEXT("[FEM Profiling] StrainEnergy: %.3f ms (%d tets)"), StrainEnergyTimeMs, Tets.Num());
+    }
+}
+
+void UFEMCalculateComponent::UpdateGraphWeightFromStrainEnergy()
+{
+    UpdateGraphWeightFromImpact(GetCurrentImpact());
+}
+
+void UFEMCalculateComponent::UpdateGraphWeightFromImpact(const FFEMImpact& Impact)
+{
+    TArray<FVector3f> Displacement;
+    BuildKelvinDisplacementField(Impact, Displacement);
+    UpdateGraphWeightFromDisplacement(Displacement);
+}
+
 void UFEMCalculateComponent::KMatrixSequential()
 {
     KElements.SetNum(Tets.Num());
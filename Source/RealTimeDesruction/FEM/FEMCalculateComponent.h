@@ -81,6 +81,14 @@ class UTetMeshGenerateComponent;
  * ==================================================================================
  */
 
+// 한 번의 충돌에 대한 충격 정보. 파괴 작업은 게임 스레드에서 복사한 값을 워커 스레드로 넘김
+struct FFEMImpact
+{
+	TArray<uint32> ImpactPoints;	// 충돌 삼각형의 사면체 정점
+	FVector HitPoint = FVector::ZeroVector;
+	FVector ImpactForce = FVector::ZeroVector;
+};
+
 UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
 class REALTIMEDESRUCTION_API UFEMCalculateComponent : public UActorComponent
 {
@@ -117,6 +125,13 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Performance")
 	double ParallelSearchTimeMs = 0.0;
 
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Performance")
+	double StrainEnergyTimeMs = 0.0;
+
+	/** 사면체 변형 에너지를 그래프 에지 가중치로 변환할 때 곱하는 계수 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dataflow", meta = (ClampMin = "0.0"))
+	float StrainEnergyWeightScale = 1.f;
+
 	/**
 	 * FEM을 사용하여 충돌 지점에서의 변형 에너지를 계산
 	 *
@@ -135,6 +150,28 @@ public:
 	 */
 	UFUNCTION(BlueprintCallable)
 	float CalculateEnergyAtTatUsingFEM(const FVector& Velocity, const FVector& NextTickVelocity, const float Mass, const FVector& HitPoint);
+
+	/**
+	 * 마지막 충격으로부터 메쉬 전체의 변위장을 만들고 모든 사면체의 변형 에너지로 그래프 가중치를 갱신
+	 *
+	 * 변위장: 무한 탄성체의 점하중 해(Kelvin Solution)
+	 * u(r) = 1 / (16πμ(1-ν)|r|) * [(3-4ν)F + r(r·F)/|r|²]
+	 * 결과는 VertexStrainEnergy와 그래프 에지 가중치에 기록됨
+	 */
+	UFUNCTION(BlueprintCallable)
+	void UpdateGraphWeightFromStrainEnergy();
+
+	/** UpdateGraphWeightFromStrainEnergy와 같지만 마지막 충격 대신 주어진 충격 사용 (워커 스레드용) */
+	void UpdateGraphWeightFromImpact(const FFEMImpact& Impact);
+
+	/**
+	 * 주어진 변위장(정점별, m 단위)으로 모든 사면체의 변형 에너지를 SIMD로 병렬 계산하고
+	 * 부피 가중 에너지를 정점과 그래프 에지에 분배
+	 *
+	 * 정점 에너지: 인접 사면체 에너지 E = ψV 의 1/4 합 (Lumped)
+	 * 에지 가중치: 양 끝 정점 에너지의 평균 × StrainEnergyWeightScale
+	 */
+	void UpdateGraphWeightFromDisplacement(const TArray<FVector3f>& Displacement);
 	
 	//! Energy at which to stop optimizing tet quality and accept the result.
 	UPROPERTY(EditAnywhere, Category = "Dataflow", meta = (ClampMin = "0.0"))
@@ -174,10 +211,31 @@ public:
 	// 사면체 4개 정점의 인덱스 배열
 	TArray<FIntVector4> Tets;
 
+	// 사면체 메쉬의 고유 에지 (X < Y로 정렬된 정점 쌍)
+	TArray<FIntPoint> TetEdges;
+
+	// 사면체별 6개 에지의 TetEdges 인덱스 (01, 02, 03, 12, 13, 23 순서)
+	TArray<int32> TetEdgeIndices;
+
+	// 렌더 메쉬(LOD0) 버텍스 인덱스 → 사면체 정점 인덱스, 대응 정점이 없으면 INDEX_NONE
+	TArray<int32> RenderToTetVertex;
+
 	WeightedGraph Graph{ false };
 
 	TArray<uint32> CurrentImpactPoint;
 
+	// 마지막 충돌의 충격력과 충돌 지점
+	FVector CurrentImpactForce = FVector::ZeroVector;
+	FVector CurrentHitPoint = FVector::ZeroVector;
+
+	FFEMImpact GetCurrentImpact() const { return { CurrentImpactPoint, CurrentHitPoint, CurrentImpactForce }; }
+
+	// 파괴 작업이 워커 스레드에서 Graph를 갱신하는 동안 true. 이 동안 들어온 충격은 에너지 0으로 거부
+	std::atomic<bool> bDestructionLocked{ false };
+
+	// UpdateGraphWeightFromDisplacement 결과 정점별 변형 에너지
+	TArray<float> VertexStrainEnergy;
+
 protected:
 
 	virtual void BeginPlay() override;
@@ -203,6 +261,20 @@ private:
 	 */
 	void GenerateGraphFromTets();
 
+	/**
+	 * 사면체 에지를 정렬된 정점 쌍으로 모아 고유 에지 테이블 생성
+	 * 메쉬 분리 시 에지마다 분리 정점을 한 번만 만들기 위해 사용
+	 */
+	void BuildTetEdgeTable();
+
+	/**
+	 * 렌더 메쉬 버텍스와 같은 위치의 사면체 정점을 찾아 RenderToTetVertex 구성
+	 *
+	 * 사면체 정점을 양자화한 격자(Spatial Hash)에 넣고 주변 27칸만 검사
+	 * 사면체 메쉬 생성 시 한 번만 수행
+	 */
+	void BuildRenderToTetVertexMap(const TArray<FVector>& RenderVertices);
+
 	/**
 	 * Sequential과 Parallel 검색 성능을 비교
 	 *
@@ -217,6 +289,30 @@ private:
 	/** 각 사면체의 12x12 강성 행렬(Stiffness Matrix) 배열 */
 	TArray<Matrix<float, 12, 12>> KElements;
 
+	/**
+	 * 전체 사면체 변형 에너지 커널용 사전 계산 데이터 (SoA, 4개 단위로 패딩)
+	 * TetShapeGradients[(i * 3 + b) * NumPaddedTets + t] = 사면체 t의 형상함수 미분 ∂N_i/∂x_b
+	 */
+	TArray<float> TetShapeGradients;
+	TArray<float> TetRestVolumes;
+	int32 NumPaddedTets = 0;
+
+	/** 정점 → 인접 사면체 목록 (CSR) */
+	TArray<int32> VertexTetOffsets;
+	TArray<int32> VertexTetIndices;
+
+	/** Kelvin 변위장의 특이점을 피하기 위한 최소 반경 (m) */
+	float KelvinCoreRadius = 0.01f;
+
+	/** 형상함수 미분, 부피, 정점-사면체 인접 정보 사전 계산 */
+	void PrecomputeStrainKernelData();
+
+	/** 4개 사면체씩 SIMD로 묶어 모든 사면체의 변형 에너지 E = ψV 계산 */
+	void ComputeTetStrainEnergies(const TArray<FVector3f>& Displacement, TArray<float>& OutTetEnergy) const;
+
+	/** 충격력에 대한 Kelvin 변위장 계산 (m 단위) */
+	void BuildKelvinDisplacementField(const FFEMImpact& Impact, TArray<FVector3f>& OutDisplacement) const;
+
 	/**
 	 * 사면체의 변형 에너지를 계산
 	 *
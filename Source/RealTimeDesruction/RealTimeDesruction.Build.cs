@@ -11,7 +11,8 @@ public class RealTimeDesruction : ModuleRules
 		PublicDependencyModuleNames.AddRange(new string[] { 
 			"Core", "CoreUObject", "Engine", "InputCore", "EnhancedInput", "ProceduralMeshComponent",
 			"GeometryAlgorithms",
-			"Eigen", "MeshDescription"
+			"Eigen", "MeshDescription",
+			"GeometryCore", "GeometryFramework"
 
 
 
@@ -0,0 +1,221 @@
+#include "FragmentBudgetSubsystem.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+
+DECLARE_CYCLE_STAT(TEXT("Fragment Budget Update"), STAT_FragmentBudgetUpdate, STATGROUP_Destruction);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Live Fragments"), STAT_LiveFragments, STATGROUP_Destruction);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Simulating Fragments"), STAT_SimulatingFragments, STATGROUP_Destruction);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Static Fragments"), STAT_StaticFragments, STATGROUP_Destruction);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Despawned Fragments (Total)"), STAT_DespawnedFragments, STATGROUP_Destruction);
+
+bool UFragmentBudgetSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UFragmentBudgetSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFragmentBudgetSubsystem, STATGROUP_Tickables);
+}
+
+void UFragmentBudgetSubsystem::RegisterFragment(ASplitActor* Actor)
+{
+	if (!IsValid(Actor))
+		return;
+
+	// 풀에서 재사용된 액터는 이전 항목이 아직 남아 있을 수 있으므로 액터당 한 항목만 유지하고 상태를 새로 시작
+	FTrackedFragment* Fragment = nullptr;
+	if (const int32* Index = FragmentIndices.Find(Actor))
+	{
+		Fragment = &Fragments[*Index];
+	}
+	else
+	{
+		FragmentIndices.Add(Actor, Fragments.Num());
+		Fragment = &Fragments.AddDefaulted_GetRef();
+		Fragment->Actor = Actor;
+	}
+
+	Fragment->SpawnTime = GetWorld()->GetTimeSeconds();
+	Fragment->SleepStartTime = -1.0;
+}
+
+void UFragmentBudgetSubsystem::Tick(float DeltaTime)
+{
+	TimeSinceUpdate += DeltaTime;
+	if (TimeSinceUpdate < UpdateInterval)
+		return;
+
+	TimeSinceUpdate = 0.f;
+	UpdateBudget();
+}
+
+void UFragmentBudgetSubsystem::GatherViewLocations(TArray<FVector>& OutLocations) const
+{
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PC = It->Get();
+		if (!PC)
+			continue;
+
+		FVector Location;
+		FRotator Rotation;
+		PC->GetPlayerViewPoint(Location, Rotation);
+		OutLocations.Add(Location);
+	}
+}
+
+void UFragmentBudgetSubsystem::UpdateBudget()
+{
+	SCOPE_CYCLE_COUNTER(STAT_FragmentBudgetUpdate);
+
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	TArray<FVector> ViewLocations;
+	GatherViewLocations(ViewLocations);
+
+	struct FCandidate
+	{
+		int32 Index;
+		float Priority;		// 클수록 먼저 제거/정지
+	};
+	TArray<FCandidate> Candidates;
+	Candidates.Reserve(Fragments.Num());
+
+	int32 NumDespawned = 0;
+	int32 NumStatic = 0;
+	NumSimulating = 0;
+
+	// 개별 정책: 거리, 수명, 크기, 안정화. 남는 조각만 Kept에 모음
+	TArray<FTrackedFragment> Kept;
+	Kept.Reserve(Fragments.Num());
+
+	for (FTrackedFragment& Fragment : Fragments)
+	{
+		ASplitActor* Actor = Fragment.Actor.Get();
+
+		// 파괴되었거나 이미 풀로 돌아간 조각은 추적 해제
+		if (!IsValid(Actor) || !Actor->GetActiveMesh())
+			continue;
+
+		UPrimitiveComponent* Mesh = Actor->GetActiveMesh();
+		const FVector Location = Mesh->GetComponentLocation();
+		const float Age = (float)(Now - Fragment.SpawnTime);
+		const float Volume = Actor->GetFragmentVolume();
+
+		float MinDistSq = 0.f;
+		if (ViewLocations.Num() > 0)
+		{
+			MinDistSq = TNumericLimits<float>::Max();
+			for (const FVector& View : ViewLocations)
+				MinDistSq = FMath::Min(MinDistSq, (float)FVector::DistSquared(View, Location));
+		}
+
+		const bool bTooFar = MaxFragmentDistance > 0.f && MinDistSq > FMath::Square(MaxFragmentDistance);
+		const bool bTooOld = MaxFragmentAge > 0.f && Age > MaxFragmentAge;
+		const bool bTooSmall = Volume > 0.f && Volume < SmallFragmentVolume && Age > SmallFragmentAge;
+		if (bTooFar || bTooOld || bTooSmall)
+		{
+			Actor->Despawn();
+			++NumDespawned;
+			continue;
+		}
+
+		if (Actor->IsSimulating())
+		{
+			if (SettleTime > 0.f && !Mesh->RigidBodyIsAwake())
+			{
+				if (Fragment.SleepStartTime < 0.0)
+					Fragment.SleepStartTime = Now;
+				else if (Now - Fragment.SleepStartTime > SettleTime)
+					Actor->Freeze();
+			}
+			else
+			{
+				Fragment.SleepStartTime = -1.0;
+			}
+		}
+
+		if (Actor->IsSimulating())
+			++NumSimulating;
+		else
+			++NumStatic;
+
+		// 멀고, 오래되고, 작은 조각일수록 우선순위가 높음
+		const float Priority = FMath::Sqrt(MinDistSq) * (1.f + Age) / (1.f + FMath::Pow(Volume, 1.f / 3.f));
+		Candidates.Add({ Kept.Add(Fragment), Priority });
+	}
+
+	// 전체 예산 정책
+	const bool bOverLive = MaxLiveFragments > 0 && Candidates.Num() > MaxLiveFragments;
+	const bool bOverSimulating = MaxSimulatingFragments > 0 && NumSimulating > MaxSimulatingFragments;
+	if (bOverLive || bOverSimulating)
+	{
+		Candidates.Sort([](const FCandidate& A, const FCandidate& B) { return A.Priority > B.Priority; });
+
+		int32 ExcessLive = bOverLive ? Candidates.Num() - MaxLiveFragments : 0;
+		int32 ExcessSimulating = bOverSimulating ? NumSimulating - MaxSimulatingFragments : 0;
+
+		TArray<int32> Removed;
+		for (const FCandidate& Candidate : Candidates)
+		{
+			if (ExcessLive <= 0 && ExcessSimulating <= 0)
+				break;
+
+			ASplitActor* Actor = Kept[Candidate.Index].Actor.Get();
+			const bool bWasSimulating = Actor->IsSimulating();
+
+			if (ExcessLive > 0)
+			{
+				Actor->Despawn();
+				Removed.Add(Candidate.Index);
+				--ExcessLive;
+				++NumDespawned;
+				if (bWasSimulating)
+				{
+					--NumSimulating;
+					--ExcessSimulating;
+				}
+				else
+				{
+					--NumStatic;
+				}
+			}
+			else if (bWasSimulating)
+			{
+				// 움직이는 바디를 정지시키면 공중에 멈추므로 잠든 조각만 정지하고 나머지는 Despawn
+				UPrimitiveComponent* Mesh = Actor->GetActiveMesh();
+				if (Mesh && !Mesh->RigidBodyIsAwake())
+				{
+					Actor->Freeze();
+					++NumStatic;
+				}
+				else
+				{
+					Actor->Despawn();
+					Removed.Add(Candidate.Index);
+					++NumDespawned;
+				}
+				--NumSimulating;
+				--ExcessSimulating;
+			}
+		}
+
+		// 뒤쪽 인덱스부터 지워 앞쪽 인덱스 유지
+		Removed.Sort(TGreater<int32>());
+		for (const int32 Index : Removed)
+			Kept.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	}
+
+	Fragments = MoveTemp(Kept);
+	NumLive = Fragments.Num();
+
+	FragmentIndices.Reset();
+	for (int32 i = 0; i < Fragments.Num(); ++i)
+		FragmentIndices.Add(Fragments[i].Actor, i);
+
+	SET_DWORD_STAT(STAT_LiveFragments, NumLive);
+	SET_DWORD_STAT(STAT_SimulatingFragments, NumSimulating);
+	SET_DWORD_STAT(STAT_StaticFragments, NumStatic);
+	INC_DWORD_STAT_BY(STAT_DespawnedFragments, NumDespawned);
+}
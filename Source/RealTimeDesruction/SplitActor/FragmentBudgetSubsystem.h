@@ -0,0 +1,84 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SplitActor.h"
+#include "FragmentBudgetSubsystem.generated.h"
+
+DECLARE_STATS_GROUP(TEXT("Destruction"), STATGROUP_Destruction, STATCAT_Advanced);
+
+/**
+ * 조각 예산 관리
+ *
+ * 살아 있는 ASplitActor 수와 시뮬레이션 중인 바디 수를 제한
+ * 거리, 수명, 크기 기준으로 조각을 Despawn하고, 일정 시간 잠든 조각은 정적 충돌체로 전환
+ * 플랫폼별 조정은 DefaultGame.ini의 [/Script/RealTimeDesruction.FragmentBudgetSubsystem]에서
+ * 통계는 콘솔 "stat Destruction"
+ */
+UCLASS(config = Game)
+class REALTIMEDESRUCTION_API UFragmentBudgetSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	void RegisterFragment(ASplitActor* Actor);
+
+	UFUNCTION(BlueprintPure, Category = "Destruction")
+	int32 GetNumLiveFragments() const { return NumLive; }
+
+	UFUNCTION(BlueprintPure, Category = "Destruction")
+	int32 GetNumSimulatingFragments() const { return NumSimulating; }
+
+	// 살아 있는 조각의 최대 수. 넘으면 우선순위가 낮은 조각부터 Despawn. 0이면 제한 없음
+	UPROPERTY(config, EditAnywhere, BlueprintReadWrite, Category = "Destruction", meta = (ClampMin = "0"))
+	int32 MaxLiveFragments = 512;
+
+	// 동시에 시뮬레이션하는 바디의 최대 수. 넘으면 우선순위가 낮은 조각부터 잠든 조각은 정지, 움직이는 조각은 Despawn. 0이면 제한 없음
+	UPROPERTY(config, EditAnywhere, BlueprintReadWrite, Category = "Destruction", meta = (ClampMin = "0"))
+	int32 MaxSimulatingFragments = 128;
+
+	// 모든 플레이어 시점에서 이 거리(cm)보다 멀면 Despawn. 0이면 사용 안 함
+	UPROPERTY(config, EditAnywhere, BlueprintReadWrite, Category = "Destruction", meta = (ClampMin = "0.0"))
+	float MaxFragmentDistance = 10000.f;
+
+	// 이 시간(초)이 지난 조각은 Despawn. 0이면 사용 안 함
+	UPROPERTY(config, EditAnywhere, BlueprintReadWrite, Category = "Destruction", meta = (ClampMin = "0.0"))
+	float MaxFragmentAge = 0.f;
+
+	// 부피가 SmallFragmentVolume(cm³) 미만인 조각은 SmallFragmentAge(초) 후 Despawn
+	UPROPERTY(config, EditAnywhere, BlueprintReadWrite, Category = "Destruction", meta = (ClampMin = "0.0"))
+	float SmallFragmentVolume = 1.f;
+
+	UPROPERTY(config, EditAnywhere, BlueprintReadWrite, Category = "Destruction", meta = (ClampMin = "0.0"))
+	float SmallFragmentAge = 5.f;
+
+	// 이 시간(초) 동안 잠들어 있던 조각은 시뮬레이션을 끄고 정적 충돌체로 전환. 0이면 사용 안 함
+	UPROPERTY(config, EditAnywhere, BlueprintReadWrite, Category = "Destruction", meta = (ClampMin = "0.0"))
+	float SettleTime = 2.f;
+
+	// 예산 검사 주기(초)
+	UPROPERTY(config, EditAnywhere, BlueprintReadWrite, Category = "Destruction", meta = (ClampMin = "0.0"))
+	float UpdateInterval = 0.25f;
+
+private:
+	struct FTrackedFragment
+	{
+		TWeakObjectPtr<ASplitActor> Actor;
+		double SpawnTime = 0.0;
+		double SleepStartTime = -1.0;
+	};
+
+	void UpdateBudget();
+	void GatherViewLocations(TArray<FVector>& OutLocations) const;
+
+	TArray<FTrackedFragment> Fragments;
+	// 액터 → Fragments 인덱스. 등록 시 중복 검사용, UpdateBudget마다 다시 만듦
+	TMap<TWeakObjectPtr<ASplitActor>, int32> FragmentIndices;
+	float TimeSinceUpdate = 0.f;
+	int32 NumLive = 0;
+	int32 NumSimulating = 0;
+};
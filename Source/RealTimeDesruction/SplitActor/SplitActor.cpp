@@ -2,6 +2,11 @@
 
 
 #include "SplitActor.h"
+#include "SplitActorPool.h"
+#include "TimerManager.h"
+#include "PhysicsEngine/AggregateGeom.h"
+#include "PhysicsEngine/BodyInstance.h"
+#include "Physics/PhysicsInterfaceCore.h"
 
 // Sets default values
 ASplitActor::ASplitActor()
@@ -12,7 +17,15 @@ ASplitActor::ASplitActor()
 	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("RootComponent"));
 	SetRootComponent(RootComponent);
 	RootComponent->SetMobility(EComponentMobility::Movable);
-	
+
+	// 풀에서 재사용할 수 있도록 메쉬 컴포넌트를 미리 만들어 등록해 둠
+	ProceduralMesh = CreateDefaultSubobject<UProceduralMeshComponent>(TEXT("ProceduralMesh"));
+	ProceduralMesh->SetupAttachment(RootComponent);
+	ProceduralMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+
+	DynamicMesh = CreateDefaultSubobject<UDynamicMeshComponent>(TEXT("DynamicMesh"));
+	DynamicMesh->SetupAttachment(RootComponent);
+	DynamicMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
 }
 
 // Called when the game starts or when spawned
@@ -31,9 +44,9 @@ void ASplitActor::Tick(float DeltaTime)
 
 void ASplitActor::SetProceduralMesh(UProceduralMeshComponent* Mesh, TArray<UMaterialInterface*> Materials)
 {
-	ProceduralMesh = NewObject<UProceduralMeshComponent>(this);
 	if (Mesh->GetProcMeshSection(0))
 	{
+		ActiveMesh = ProceduralMesh;
 		ProceduralMesh->SetProcMeshSection(0, *(Mesh->GetProcMeshSection(0)));
 
 		for (int i = 0; i < Materials.Num(); ++i)
@@ -44,20 +57,24 @@ void ASplitActor::SetProceduralMesh(UProceduralMeshComponent* Mesh, TArray<UMate
 		ProceduralMesh->SetCollisionObjectType(ECollisionChannel::ECC_PhysicsBody);
 		ProceduralMesh->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Block);
 		ProceduralMesh->bUseComplexAsSimpleCollision = false;
-
-		ProceduralMesh->AttachToComponent(GetRootComponent(), FAttachmentTransformRules::KeepRelativeTransform);
-		ProceduralMesh->RegisterComponent();
 	}
 	else
 		UE_LOG(LogTemp, Warning, TEXT("Invalid Procedural Mesh!"));
 
 }
 
-void ASplitActor::GenerateCollisionConvexMesh()
+void ASplitActor::GenerateCollisionConvexMesh(const TArray<FVector>& CollisionHull)
 {
 	if (ProceduralMesh->GetProcMeshSection(0))
 	{
+		ProceduralMesh->bUseAsyncCooking = true;
 		ProceduralMesh->ClearCollisionConvexMeshes();
+		if (CollisionHull.Num() > 0)
+		{
+			ProceduralMesh->AddCollisionConvexMesh(CollisionHull);
+			return;
+		}
+
 		TArray<FVector> ConvexVerts;
 		for (const FProcMeshVertex& Vertex : ProceduralMesh->GetProcMeshSection(0)->ProcVertexBuffer)
 		{
@@ -67,4 +84,176 @@ void ASplitActor::GenerateCollisionConvexMesh()
 	}
 	else
 		UE_LOG(LogTemp, Warning, TEXT("Failed To Generate Convex Mesh!"));
-}
\ No newline at end of file
+}
+
+void ASplitActor::SetMesh(UE::Geometry::FDynamicMesh3&& Mesh, const TArray<UMaterialInterface*>& Materials, const FFragmentCollision& Collision)
+{
+	if (Mesh.TriangleCount() == 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Invalid Dynamic Mesh!"));
+		return;
+	}
+
+	FKAggregateGeom AggGeom;
+	if (Collision.Tier == EFragmentCollisionTier::Sphere)
+	{
+		FKSphereElem& Sphere = AggGeom.SphereElems.Emplace_GetRef(Collision.Radius);
+		Sphere.Center = Collision.Center;
+	}
+	else if (Collision.Tier == EFragmentCollisionTier::Box)
+	{
+		FKBoxElem& Box = AggGeom.BoxElems.Emplace_GetRef(Collision.Extent.X * 2, Collision.Extent.Y * 2, Collision.Extent.Z * 2);
+		Box.Center = Collision.Center;
+		Box.Rotation = Collision.Rotation.Rotator();
+	}
+	else
+	{
+		FKConvexElem& Convex = AggGeom.ConvexElems.AddDefaulted_GetRef();
+		if (Collision.Hull.Num() > 0)
+		{
+			Convex.VertexData = Collision.Hull;
+		}
+		else
+		{
+			for (const FVector3d& Vertex : Mesh.VerticesItr())
+			{
+				Convex.VertexData.Add(Vertex);
+			}
+		}
+		Convex.UpdateElemBox();
+	}
+
+	ActiveMesh = DynamicMesh;
+	DynamicMesh->SetMesh(MoveTemp(Mesh));
+
+	for (int i = 0; i < Materials.Num(); ++i)
+		DynamicMesh->SetMaterial(i, Materials[i]);
+
+	DynamicMesh->bUseAsyncCooking = true;
+	DynamicMesh->CollisionType = ECollisionTraceFlag::CTF_UseSimpleAsComplex;
+	DynamicMesh->SetSimpleCollisionShapes(AggGeom, true);
+
+	DynamicMesh->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+	DynamicMesh->SetCollisionObjectType(ECollisionChannel::ECC_PhysicsBody);
+	DynamicMesh->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Block);
+
+	DynamicMesh->SetSimulatePhysics(true);
+}
+
+void ASplitActor::SetMassProperties(const FFragmentMassProperties& Properties, const float Density)
+{
+	UPrimitiveComponent* Component = ActiveMesh;
+	if (!Component || Properties.Volume <= 0.0)
+		return;
+
+	// 액터 스케일 반영: 부피는 세 축 배율의 곱, 관성은 평균 배율의 제곱을 추가로 곱해 근사
+	const FVector Scale = GetActorScale3D().GetAbs();
+	const double VolumeScale = Scale.X * Scale.Y * Scale.Z;
+	const double LengthScale = (Scale.X + Scale.Y + Scale.Z) / 3.0;
+
+	// g/cm³ → kg/cm³
+	const double KgPerVolume = Density * 0.001;
+	FragmentVolume = (float)(Properties.Volume * VolumeScale);
+	FragmentMass = (float)(FragmentVolume * KgPerVolume);
+	FragmentInertia = Properties.PrincipalInertia * (VolumeScale * LengthScale * LengthScale * KgPerVolume);
+	FragmentMassFrame = FTransform(Properties.PrincipalRotation, Properties.CenterOfMass * Scale);
+	bHasMassProperties = true;
+
+	FBodyInstance* Body = Component->GetBodyInstance();
+	if (!Body)
+		return;
+
+	Body->SetMassOverride(FragmentMass, true);
+
+	// 충돌 쿠킹이 끝나 바디가 다시 만들어지면 엔진이 질량 특성을 다시 계산하므로 그때마다 덮어씀
+	Body->OnRecalculatedMassProperties().AddUObject(this, &ASplitActor::ApplyMassProperties);
+	if (Body->IsValidBodyInstance())
+		ApplyMassProperties(Body);
+}
+
+void ASplitActor::ApplyMassProperties(FBodyInstance* Body)
+{
+	if (!bHasMassProperties || !Body || !Body->IsValidBodyInstance())
+		return;
+
+	FPhysicsCommand::ExecuteWrite(Body->ActorHandle, [this](const FPhysicsActorHandle& Actor)
+		{
+			FPhysicsInterface::SetMass_AssumesLocked(Actor, FragmentMass);
+			FPhysicsInterface::SetMassSpaceInertiaTensor_AssumesLocked(Actor, FragmentInertia);
+			FPhysicsInterface::SetComLocalPose_AssumesLocked(Actor, FragmentMassFrame);
+		});
+}
+
+void ASplitActor::ResetForPool()
+{
+	GetWorldTimerManager().ClearTimer(LifetimeTimer);
+
+	for (UPrimitiveComponent* Component : { (UPrimitiveComponent*)ProceduralMesh, (UPrimitiveComponent*)DynamicMesh })
+	{
+		if (FBodyInstance* Body = Component->GetBodyInstance())
+			Body->OnRecalculatedMassProperties().RemoveAll(this);
+
+		// 물리 시뮬레이션 중 분리된 컴포넌트를 루트로 되돌림
+		Component->SetSimulatePhysics(false);
+		Component->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		Component->AttachToComponent(GetRootComponent(), FAttachmentTransformRules::SnapToTargetNotIncludingScale);
+		Component->SetRelativeTransform(FTransform::Identity);
+	}
+
+	ProceduralMesh->ClearAllMeshSections();
+	ProceduralMesh->ClearCollisionConvexMeshes();
+	DynamicMesh->SetSimpleCollisionShapes(FKAggregateGeom(), false);
+	DynamicMesh->SetMesh(UE::Geometry::FDynamicMesh3());
+
+	ActiveMesh = nullptr;
+	bHasMassProperties = false;
+	FragmentVolume = 0.f;
+
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+	SetActorTickEnabled(false);
+}
+
+void ASplitActor::ActivateFromPool(const FTransform& Transform)
+{
+	SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+}
+
+void ASplitActor::SetLifetime(const float Seconds)
+{
+	GetWorldTimerManager().ClearTimer(LifetimeTimer);
+	if (Seconds > 0.f)
+		GetWorldTimerManager().SetTimer(LifetimeTimer, this, &ASplitActor::Despawn, Seconds, false);
+}
+
+void ASplitActor::Despawn()
+{
+	if (USplitActorPool* Pool = OwningPool.Get())
+		Pool->Release(this);
+	else
+		Destroy();
+}
+
+bool ASplitActor::IsSimulating() const
+{
+	return ActiveMesh && ActiveMesh->IsSimulatingPhysics();
+}
+
+void ASplitActor::Freeze()
+{
+	if (!IsSimulating())
+		return;
+
+	// 시뮬레이션 중 분리된 컴포넌트의 월드 위치를 유지한 채 고정
+	ActiveMesh->SetSimulatePhysics(false);
+}
+
+void ASplitActor::SetFragmentEnabled(const bool bEnabled)
+{
+	SetActorHiddenInGame(!bEnabled);
+	SetActorEnableCollision(bEnabled);
+	if (ActiveMesh)
+		ActiveMesh->SetSimulatePhysics(bEnabled);
+}
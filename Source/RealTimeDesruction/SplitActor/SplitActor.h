@@ -3,9 +3,13 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "ProceduralMeshComponent.h"
+#include "Components/DynamicMeshComponent.h"
+#include "../SplitMesh/SplitMesh.h"
 #include "Materials/MaterialInterface.h"
 #include "SplitActor.generated.h"
 
+class USplitActorPool;
+
 UCLASS()
 class REALTIMEDESRUCTION_API ASplitActor : public AActor
 {
@@ -24,9 +28,58 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
 	UProceduralMeshComponent* ProceduralMesh;
 
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
+	UDynamicMeshComponent* DynamicMesh;
+
+	// 현재 조각 메쉬를 표시 중인 컴포넌트 (ProceduralMesh 또는 DynamicMesh)
+	UPROPERTY(Transient)
+	UPrimitiveComponent* ActiveMesh = nullptr;
+
 public:
 	// Called every frame
 	virtual void Tick(float DeltaTime) override;
 	void SetProceduralMesh(UProceduralMeshComponent* Mesh, TArray<UMaterialInterface*> Materials);
-	void GenerateCollisionConvexMesh();
+	// CollisionHull이 비어 있으면 섹션의 모든 정점 사용. 쿠킹은 비동기로 한 번만 수행
+	void GenerateCollisionConvexMesh(const TArray<FVector>& CollisionHull = TArray<FVector>());
+
+	// 조각 메쉬를 이동으로 받아 컴포넌트 생성 (복사 없음), 크기 티어별 충돌 형상(구, 상자, 볼록 껍질)으로 단순 충돌 구성
+	void SetMesh(UE::Geometry::FDynamicMesh3&& Mesh, const TArray<UMaterialInterface*>& Materials, const FFragmentCollision& Collision);
+
+	// 사면체에서 계산한 질량, 질량 중심, 관성 텐서를 물리 바디에 직접 적용 (Density: g/cm³)
+	void SetMassProperties(const FFragmentMassProperties& Properties, const float Density);
+
+	// 풀 재사용: 메쉬, 충돌, 물리 상태를 비우고 숨김
+	void ResetForPool();
+	void ActivateFromPool(const FTransform& Transform);
+
+	// Seconds 후 Despawn. 0 이하이면 유지
+	void SetLifetime(const float Seconds);
+
+	// 풀에서 왔으면 풀로 반환, 아니면 파괴
+	UFUNCTION(BlueprintCallable)
+	void Despawn();
+
+	TWeakObjectPtr<USplitActorPool> OwningPool;
+
+	UPrimitiveComponent* GetActiveMesh() const { return ActiveMesh; }
+	// 스케일 반영 부피 (cm³). 질량 특성이 없으면 0
+	float GetFragmentVolume() const { return FragmentVolume; }
+	bool IsSimulating() const;
+
+	// 물리 시뮬레이션을 끄고 현재 위치에 정적 충돌체로 남김
+	void Freeze();
+
+	// 표시, 충돌, 물리를 함께 켜고 끔 (점진 생성 중 공개 전 대기용)
+	void SetFragmentEnabled(const bool bEnabled);
+
+private:
+	void ApplyMassProperties(FBodyInstance* Body);
+
+	FTimerHandle LifetimeTimer;
+
+	bool bHasMassProperties = false;
+	float FragmentVolume = 0.f;					// cm³
+	float FragmentMass = 0.f;					// kg
+	FVector FragmentInertia = FVector::ZeroVector;	// kg·cm²
+	FTransform FragmentMassFrame;				// 질량 중심 위치와 주축 회전
 };
\ No newline at end of file
@@ -0,0 +1,81 @@
+#include "SplitActorPool.h"
+#include "Engine/World.h"
+
+bool USplitActorPool::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void USplitActorPool::Deinitialize()
+{
+	Dormant.Empty();
+	Super::Deinitialize();
+}
+
+ASplitActor* USplitActorPool::SpawnDormant()
+{
+	UWorld* World = GetWorld();
+	if (!World)
+		return nullptr;
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	ASplitActor* Actor = World->SpawnActor<ASplitActor>(ASplitActor::StaticClass(), FTransform::Identity, SpawnParams);
+	if (!Actor)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to spawn pooled split actor."));
+		return nullptr;
+	}
+
+	Actor->OwningPool = this;
+	Actor->ResetForPool();
+	return Actor;
+}
+
+ASplitActor* USplitActorPool::Acquire(const FTransform& Transform)
+{
+	ASplitActor* Actor = nullptr;
+	while (!Actor && Dormant.Num() > 0)
+	{
+		Actor = Dormant.Pop(EAllowShrinking::No);
+		if (!IsValid(Actor))
+			Actor = nullptr;
+	}
+
+	if (!Actor)
+		Actor = SpawnDormant();
+
+	if (Actor)
+		Actor->ActivateFromPool(Transform);
+
+	return Actor;
+}
+
+void USplitActorPool::Release(ASplitActor* Actor)
+{
+	if (!IsValid(Actor))
+		return;
+
+	if (Dormant.Num() >= MaxPooledActors)
+	{
+		Actor->OwningPool.Reset();
+		Actor->Destroy();
+		return;
+	}
+
+	Actor->ResetForPool();
+	Dormant.Add(Actor);
+}
+
+void USplitActorPool::Prewarm(int32 Count)
+{
+	Count = FMath::Min(Count, MaxPooledActors);
+	while (Dormant.Num() < Count)
+	{
+		ASplitActor* Actor = SpawnDormant();
+		if (!Actor)
+			break;
+		Dormant.Add(Actor);
+	}
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SplitActor.h"
+#include "SplitActorPool.generated.h"
+
+/**
+ * 조각 액터 풀
+ *
+ * 파괴 때마다 액터를 생성/파괴하는 대신 메쉬 컴포넌트가 등록된 휴면 ASplitActor를 재사용
+ * Acquire로 꺼내고, ASplitActor::Despawn 또는 Release로 반환
+ */
+UCLASS()
+class REALTIMEDESRUCTION_API USplitActorPool : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+
+	// 휴면 액터를 Transform 위치에 활성화. 풀이 비어 있으면 새로 생성
+	ASplitActor* Acquire(const FTransform& Transform);
+
+	// 액터를 초기화해 풀에 반환. 풀이 가득 차면 파괴
+	void Release(ASplitActor* Actor);
+
+	// 휴면 액터를 Count개가 될 때까지 미리 생성
+	UFUNCTION(BlueprintCallable, Category = "Destruction")
+	void Prewarm(int32 Count);
+
+	UFUNCTION(BlueprintPure, Category = "Destruction")
+	int32 GetNumDormant() const { return Dormant.Num(); }
+
+	// 풀에 보관할 최대 휴면 액터 수
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Destruction", meta = (ClampMin = "0"))
+	int32 MaxPooledActors = 256;
+
+private:
+	ASplitActor* SpawnDormant();
+
+	UPROPERTY()
+	TArray<TObjectPtr<ASplitActor>> Dormant;
+};
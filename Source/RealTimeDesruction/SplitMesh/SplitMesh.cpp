@@ -1,9 +1,259 @@
 
 #include "SplitMesh.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Algo/BinarySearch.h"
+#include "DynamicMesh/DynamicMeshAttributeSet.h"
+#include "DynamicMesh/MeshNormals.h"
+#include "CompGeom/ConvexHull3.h"
 
-std::shared_mutex seedMutex;
-std::shared_mutex tetMutex;
-std::shared_mutex vertexMutex;
+namespace
+{
+	// 정점 슬롯: 0~3 = 사면체 정점, 4~9 = 에지 분리 정점
+	enum ESlot : uint8 { V0, V1, V2, V3, M01, M02, M03, M12, M13, M23 };
+
+	// 에지 e의 양 끝 정점 (M01 = 4 + 0, ..., M23 = 4 + 5)
+	constexpr uint8 EdgeEnds[6][2] = { { 0, 1 }, { 0, 2 }, { 0, 3 }, { 1, 2 }, { 1, 3 }, { 2, 3 } };
+
+	// 사면체 로컬 정점 쌍 → 로컬 에지 번호 (UFEMCalculateComponent::TetEdgeIndices 순서와 같음)
+	constexpr int8 LocalEdge[4][4] =
+	{
+		{ -1,  0,  1,  2 },
+		{  0, -1,  3,  4 },
+		{  1,  3, -1,  5 },
+		{  2,  4,  5, -1 },
+	};
+
+	// 정규화된 정점 순서에 대한 분할 템플릿
+	struct FSplitTemplate
+	{
+		uint8 NumTets;
+		uint8 EdgeMask;		// 분리 정점이 필요한 에지 (bit e = EdgeEnds[e])
+		uint8 Tets[8][4];
+		uint8 Owner[8];		// 각 사면체가 속할 영역을 대표하는 정점 슬롯
+	};
+
+	enum ESplitTemplate : uint8 { One, TwoTwo, OneThree, Three, Four };
+
+	constexpr FSplitTemplate Templates[5] =
+	{
+		// 한 영역
+		{ 1, 0x00,
+			{ { V0, V1, V2, V3 } },
+			{ V0 } },
+		// 2-2: (A, A, B, B)
+		{ 6, 0x1E,
+			{ { V0, V1, M02, M03 }, { V1, M02, M03, M13 }, { V1, M02, M13, M12 },
+			  { M12, M02, M13, V2 }, { M03, M02, M13, V2 }, { V2, V3, M03, M13 } },
+			{ V0, V0, V0, V2, V2, V2 } },
+		// 1-3: (A, B, B, B)
+		{ 4, 0x07,
+			{ { V0, M01, M02, M03 },
+			  { M01, V1, V2, V3 }, { M02, M01, V2, V3 }, { M03, M01, M02, V3 } },
+			{ V0, V1, V1, V1 } },
+		// 세 영역: (A, B, C, C)
+		{ 7, 0x1F,
+			{ { V0, M01, M02, M03 }, { M02, M03, M01, M13 },
+			  { V1, M12, M13, M01 }, { M12, M13, M01, M02 },
+			  { M12, V2, M13, M02 }, { V2, V3, M13, M02 }, { M13, V3, M03, M02 } },
+			{ V0, V0, V1, V1, V2, V2, V2 } },
+		// 네 영역: (A, B, C, D)
+		{ 8, 0x3F,
+			{ { V0, M01, M02, M03 }, { M02, M03, M01, M13 },
+			  { V1, M12, M13, M01 }, { M12, M13, M02, M01 },
+			  { V2, M23, M12, M02 }, { M23, M13, M02, M12 },
+			  { V3, M13, M23, M03 }, { M13, M23, M03, M02 } },
+			{ V0, V0, V1, V1, V2, V2, V3, V3 } },
+	};
+
+	// 실제 정점 라벨 패턴 → 템플릿과 정규화 순서 (Perm[정규 슬롯] = 실제 정점)
+	struct FSplitCase
+	{
+		uint8 Template;
+		uint8 Perm[4];
+	};
+
+	// 라벨 패턴은 Restricted Growth String (r0 = 0, r1, r2, r3)으로 표현, 총 15가지
+	struct FSplitPattern
+	{
+		uint8 R[4];
+		FSplitCase Case;
+	};
+
+	constexpr FSplitPattern Patterns[15] =
+	{
+		{ { 0, 0, 0, 0 }, { One,      { 0, 1, 2, 3 } } },
+		{ { 0, 0, 0, 1 }, { OneThree, { 3, 0, 1, 2 } } },
+		{ { 0, 0, 1, 0 }, { OneThree, { 2, 0, 1, 3 } } },
+		{ { 0, 0, 1, 1 }, { TwoTwo,   { 0, 1, 2, 3 } } },
+		{ { 0, 0, 1, 2 }, { Three,    { 2, 3, 0, 1 } } },
+		{ { 0, 1, 0, 0 }, { OneThree, { 1, 0, 2, 3 } } },
+		{ { 0, 1, 0, 1 }, { TwoTwo,   { 0, 2, 1, 3 } } },
+		{ { 0, 1, 0, 2 }, { Three,    { 1, 3, 0, 2 } } },
+		{ { 0, 1, 1, 0 }, { TwoTwo,   { 0, 3, 1, 2 } } },
+		{ { 0, 1, 1, 1 }, { OneThree, { 0, 1, 2, 3 } } },
+		{ { 0, 1, 1, 2 }, { Three,    { 0, 3, 1, 2 } } },
+		{ { 0, 1, 2, 0 }, { Three,    { 1, 2, 0, 3 } } },
+		{ { 0, 1, 2, 1 }, { Three,    { 0, 2, 1, 3 } } },
+		{ { 0, 1, 2, 2 }, { Three,    { 0, 1, 2, 3 } } },
+		{ { 0, 1, 2, 3 }, { Four,     { 0, 1, 2, 3 } } },
+	};
+
+	constexpr int32 PatternKey(uint8 R1, uint8 R2, uint8 R3)
+	{
+		return R1 * 12 + R2 * 4 + R3;
+	}
+
+	struct FSplitCaseTable
+	{
+		FSplitCase Entries[24];
+	};
+
+	constexpr FSplitCaseTable CaseTable = []()
+	{
+		FSplitCaseTable Table{};
+		for (const FSplitPattern& Pattern : Patterns)
+		{
+			Table.Entries[PatternKey(Pattern.R[1], Pattern.R[2], Pattern.R[3])] = Pattern.Case;
+		}
+		return Table;
+	}();
+}
+
+// 점들의 볼록 껍질을 구하고 MaxVertices개 이하로 줄임
+// 껍질 정점 중 이미 고른 점들로부터 가장 먼 점을 차례로 선택 (Farthest Point Sampling)
+static TArray<FVector> ComputeCollisionHull(const TArray<FVector>& Points, const int32 MaxVertices)
+{
+	const int32 Limit = FMath::Max(MaxVertices, 4);
+	if (Points.Num() < 4)
+	{
+		return Points;
+	}
+
+	// 평면이거나 퇴화한 조각은 껍질을 못 구하므로 AABB 꼭짓점 8개 사용. 납작한 조각도 쿠킹되도록 최소 두께를 줌
+	// 한도가 8 미만이면 상자에 내접하는 사면체(서로 이웃하지 않는 꼭짓점 4개)
+	UE::Geometry::FConvexHull3d Hull;
+	if (!Hull.Solve(TArrayView<const FVector>(Points)))
+	{
+		static constexpr int32 TetCorners[4] = { 0, 3, 5, 6 };
+		const FBox Box(Points);
+		const FVector Extent = Box.GetExtent().ComponentMax(FVector(0.05));
+		const int32 NumCorners = Limit >= 8 ? 8 : 4;
+		TArray<FVector> Corners;
+		Corners.Reserve(NumCorners);
+		for (int32 i = 0; i < NumCorners; ++i)
+		{
+			const int32 Corner = NumCorners == 8 ? i : TetCorners[i];
+			const FVector Sign((Corner & 1) ? 1 : -1, (Corner & 2) ? 1 : -1, (Corner & 4) ? 1 : -1);
+			Corners.Emplace(Box.GetCenter() + Sign * Extent);
+		}
+		return Corners;
+	}
+
+	TBitArray<> IsHullVertex(false, Points.Num());
+	for (const UE::Geometry::FIndex3i& Tri : Hull.GetTriangles())
+	{
+		IsHullVertex[Tri.A] = true;
+		IsHullVertex[Tri.B] = true;
+		IsHullVertex[Tri.C] = true;
+	}
+
+	TArray<FVector> HullPoints;
+	for (TConstSetBitIterator<> It(IsHullVertex); It; ++It)
+	{
+		HullPoints.Emplace(Points[It.GetIndex()]);
+	}
+
+	if (HullPoints.Num() <= Limit)
+	{
+		return HullPoints;
+	}
+
+	FVector Center = FVector::ZeroVector;
+	for (const FVector& Point : HullPoints)
+	{
+		Center += Point;
+	}
+	Center /= HullPoints.Num();
+
+	// 중심에서 가장 먼 점부터 시작
+	TArray<double> MinDistSq;
+	MinDistSq.SetNumUninitialized(HullPoints.Num());
+	for (int32 i = 0; i < HullPoints.Num(); ++i)
+	{
+		MinDistSq[i] = FVector::DistSquared(HullPoints[i], Center);
+	}
+
+	TArray<FVector> Result;
+	Result.Reserve(Limit);
+	while (Result.Num() < Limit)
+	{
+		int32 Farthest = 0;
+		for (int32 i = 1; i < HullPoints.Num(); ++i)
+		{
+			if (MinDistSq[i] > MinDistSq[Farthest])
+			{
+				Farthest = i;
+			}
+		}
+
+		const FVector Picked = HullPoints[Farthest];
+		Result.Emplace(Picked);
+		for (int32 i = 0; i < HullPoints.Num(); ++i)
+		{
+			MinDistSq[i] = Result.Num() == 1 ? FVector::DistSquared(HullPoints[i], Picked) : FMath::Min(MinDistSq[i], FVector::DistSquared(HullPoints[i], Picked));
+		}
+	}
+
+	return Result;
+}
+
+// 영역 부피로 충돌 티어를 고름. 작은 조각은 쿠킹 없이 구나 상자로 처리
+FFragmentCollision SplitMesh::ComputeCollision(const TArray<FVector>& Points, const FFragmentMassProperties& Properties) const
+{
+	FFragmentCollision Collision;
+
+	const double Volume = Properties.Volume;
+	if (Volume > 0.0 && Volume < SphereCollisionVolume)
+		Collision.Tier = EFragmentCollisionTier::Sphere;
+	else if (Volume > 0.0 && Volume < BoxCollisionVolume)
+		Collision.Tier = EFragmentCollisionTier::Box;
+	else if (Volume > 0.0 && Volume < SimplifiedHullVolume)
+		Collision.Tier = EFragmentCollisionTier::SimplifiedHull;
+
+	if (Points.Num() == 0)
+		Collision.Tier = EFragmentCollisionTier::Hull;
+
+	if (Collision.Tier == EFragmentCollisionTier::Hull || Collision.Tier == EFragmentCollisionTier::SimplifiedHull)
+	{
+		const int32 Limit = Collision.Tier == EFragmentCollisionTier::Hull ? MaxHullVertices : FMath::Min(SimplifiedHullVertices, MaxHullVertices);
+		Collision.Hull = ComputeCollisionHull(Points, Limit);
+		return Collision;
+	}
+
+	// 관성 주축 좌표계에서의 AABB를 상자로 사용
+	FBox LocalBox(ForceInit);
+	for (const FVector& Point : Points)
+	{
+		LocalBox += Properties.PrincipalRotation.UnrotateVector(Point - Properties.CenterOfMass);
+	}
+
+	Collision.Rotation = Properties.PrincipalRotation;
+	Collision.Center = Properties.CenterOfMass + Properties.PrincipalRotation.RotateVector(LocalBox.GetCenter());
+	Collision.Extent = LocalBox.GetExtent();
+
+	// 구는 조각과 부피가 같은 반지름을 사용해 질량과 일관되게 함
+	Collision.Center = Collision.Tier == EFragmentCollisionTier::Sphere ? Properties.CenterOfMass : Collision.Center;
+	Collision.Radius = (float)FMath::Pow(3.0 * Volume / (4.0 * UE_DOUBLE_PI), 1.0 / 3.0);
+
+	Collision.Hull.Reserve(8);
+	for (int32 Corner = 0; Corner < 8; ++Corner)
+	{
+		const FVector Sign((Corner & 1) ? 1 : -1, (Corner & 2) ? 1 : -1, (Corner & 4) ? 1 : -1);
+		Collision.Hull.Emplace(Properties.CenterOfMass + Properties.PrincipalRotation.RotateVector(LocalBox.GetCenter() + Sign * Collision.Extent));
+	}
+
+	return Collision;
+}
 
 SplitMesh::SplitMesh(const UStaticMesh* Mesh, const UFEMCalculateComponent* FEMComponent, const TMap<uint32, DistOutEntry>* Distance) : Mesh(Mesh), FEMComponent(FEMComponent), Distance(Distance)
 {
@@ -12,452 +262,577 @@ SplitMesh::SplitMesh(const UStaticMesh* Mesh, const UFEMCalculateComponent* FEMC
 	SplitMesh::IndexBuffer = &LODResources.IndexBuffer;
 	NumVertices = FEMComponent->TetMeshVertices.Num();
 	this->Tets = &(FEMComponent->Tets);
+
+	// 거리 맵을 정점 인덱스로 바로 접근하는 배열로 펼침 (없는 정점은 FindRef와 같이 0)
+	Labels.Init(0, NumVertices);
+	Dists.Init(0.0, NumVertices);
+	for (const auto& Entry : *Distance)
+	{
+		if (Entry.Key < NumVertices)
+		{
+			Labels[Entry.Key] = Entry.Value.Source;
+			Dists[Entry.Key] = Entry.Value.Weight;
+		}
+	}
 }
 
-// 거리 기반 사면체 분리 위치 계산
+// 거리 필드 보간으로 사면체 분리 위치 계산
+// 양쪽 Source로부터의 거리가 같아지는 지점: Dist(p1) + x = Dist(p2) + (L - x)
 FVector3f SplitMesh::CalculateSplitPoint(const int32& p1, const int32& p2)
 {
 	FVector3f Point1 = (FVector3f)FEMComponent->TetMeshVertices[p1];
 	FVector3f Point2 = (FVector3f)FEMComponent->TetMeshVertices[p2];
-	double Dist = FVector3f::Dist(Point1, Point2);
-	double D1 = FVector3f::Dist(Point1, (FVector3f)FEMComponent->TetMeshVertices[Distance->FindRef(p1).Source]);
-	double D2 = FVector3f::Dist(Point2, (FVector3f)FEMComponent->TetMeshVertices[Distance->FindRef(p1).Source]);
-	double Weight = (((D1 + D2 + Dist) / 2) - D2) / Dist;
-	auto Result = Point1 + ((Point2 - Point1) * (1 - Weight));
-	//UE_LOG(LogTemp, Log, TEXT("Point1: (%f, %f, %f), Point2: (%f, %f, %f), Dist: %f, D1: %f, D2: %f, Weight: %f, Split Point: (%f, %f, %f)"),
-	//	Point1.X, Point1.Y, Point1.Z,
-	//	Point2.X, Point2.Y, Point2.Z,
-	//	Dist,
-	//	D1,
-	//	D2,
-	//	Weight,
-	//	Result.X, Result.Y, Result.Z);
-	return Result;
+
+	// 에지 길이는 거리 계산과 같은 그래프 비용 사용
+	double Length = FVector3f::Dist(Point1, Point2);
+	if (const TArray<Link>* Links = FEMComponent->Graph.findLinks(p1))
+	{
+		for (const Link& link : *Links)
+		{
+			if (link.VertexIndex == (uint32)p2)
+			{
+				Length = link.linkVector.Size() + link.weight;
+				break;
+			}
+		}
+	}
+
+	double Weight = 0.5;
+	if (Length > UE_SMALL_NUMBER)
+	{
+		Weight = FMath::Clamp((Dists[p2] - Dists[p1] + Length) / (2 * Length), 0.0, 1.0);
+	}
+	return Point1 + (Point2 - Point1) * (float)Weight;
 }
 
 // 버텍스가 어느 Seed에 속하는지에 따른 사면체 분리
-TMap<uint32, TArray<FIntVector4>> SplitMesh::SplitTetra(const FIntVector4& tetra)
+// 라벨 패턴으로 템플릿을 찾아 Out에 최대 8개의 사면체를 기록
+int32 SplitMesh::SplitTetra(const int32& TetIndex, FSplitTetOutput& Out) const
 {
-	TMap<uint32, TArray<FIntVector4>> Result;
-	TMap<uint32, TArray<uint32>> Sources;
-	TMap<uint32, FVector> Pos;
+	const FIntVector4& tetra = (*Tets)[TetIndex];
 
+	uint32 Label[4];
 	for (int i = 0; i < 4; ++i)
 	{
-		Sources.FindOrAdd(Distance->FindRef(tetra[i]).Source).Emplace((uint32)tetra[i]);
+		Label[i] = Labels[tetra[i]];
 	}
 
-	if (Sources.Num() == 1)
-	{
-		Result.Emplace(Sources.begin().Key(), TArray({ tetra }));
-	}
-	else if (Sources.Num() == 2)
+	// 라벨 패턴을 Restricted Growth String으로 변환
+	uint8 R[4] = { 0, 0, 0, 0 };
+	uint8 NumClasses = 1;
+	for (int i = 1; i < 4; ++i)
 	{
-		auto Source1 = Sources.begin();
-		auto& Source2 = ++Sources.begin();
-
-		if (Source1.Value().Num() == 2 && Source2.Value().Num() == 2)
+		R[i] = NumClasses;
+		for (int j = 0; j < i; ++j)
 		{
-			FIntVector4 t = FIntVector4(Source1.Value()[0], Source1.Value()[1], Source2.Value()[0], Source2.Value()[1]);
-			FVector3f M02 = CalculateSplitPoint(t[0], t[2]);
-			FVector3f M03 = CalculateSplitPoint(t[0], t[3]);
-			FVector3f M12 = CalculateSplitPoint(t[1], t[2]);
-			FVector3f M13 = CalculateSplitPoint(t[1], t[3]);
-
-			uint32 NewIndexM02;
-			uint32 NewIndexM03;
-			uint32 NewIndexM12;
-			uint32 NewIndexM13;
-
+			if (Label[j] == Label[i])
 			{
-				std::unique_lock<std::shared_mutex> lock(vertexMutex);
-				NewIndexM02 = NumVertices++;
-				NewIndexM03 = NumVertices++;
-				NewIndexM12 = NumVertices++;
-				NewIndexM13 = NumVertices++;
-
-				VerticesToAdd.Emplace(M02);
-				VerticesToAdd.Emplace(M03);
-				VerticesToAdd.Emplace(M12);
-				VerticesToAdd.Emplace(M13);
+				R[i] = R[j];
+				break;
 			}
-
-			Result.FindOrAdd(Source1.Key()).Emplace(FIntVector4(t[0], t[1], NewIndexM02, NewIndexM03));
-			Result.FindOrAdd(Source1.Key()).Emplace(FIntVector4(t[1], NewIndexM02, NewIndexM03, NewIndexM13));
-			Result.FindOrAdd(Source1.Key()).Emplace(FIntVector4(t[1], NewIndexM02, NewIndexM13, NewIndexM12));
-			Result.FindOrAdd(Source2.Key()).Emplace(FIntVector4(NewIndexM12, NewIndexM02, NewIndexM13, t[2]));
-			Result.FindOrAdd(Source2.Key()).Emplace(FIntVector4(NewIndexM03, NewIndexM02, NewIndexM13, t[2]));
-			Result.FindOrAdd(Source2.Key()).Emplace(FIntVector4(t[2], t[3], NewIndexM03, NewIndexM13));
 		}
-		else
+		if (R[i] == NumClasses)
 		{
-			FIntVector4 t;
-			uint32 key1, key2;
+			++NumClasses;
+		}
+	}
 
-			if (Source1.Value().Num() == 1)
-			{
-				t = FIntVector4(Source1.Value()[0], Source2.Value()[0], Source2.Value()[1], Source2.Value()[2]);
-				key1 = Source1.Key();
-				key2 = Source2.Key();
-			}
-			else
-			{
-				t = FIntVector4(Source2.Value()[0], Source1.Value()[0], Source1.Value()[1], Source1.Value()[2]);
-				key1 = Source2.Key();
-				key2 = Source1.Key();
-			}
+	const FSplitCase& Case = CaseTable.Entries[PatternKey(R[1], R[2], R[3])];
+	const FSplitTemplate& Template = Templates[Case.Template];
 
-			FVector3f M01 = CalculateSplitPoint(t[0], t[1]);
-			FVector3f M02 = CalculateSplitPoint(t[0], t[2]);
-			FVector3f M03 = CalculateSplitPoint(t[0], t[3]);
+	uint32 Slot[10];
+	for (int c = 0; c < 4; ++c)
+	{
+		Slot[c] = (uint32)tetra[Case.Perm[c]];
+	}
+	for (int e = 0; e < 6; ++e)
+	{
+		if (Template.EdgeMask & (1 << e))
+		{
+			const int8 Local = LocalEdge[Case.Perm[EdgeEnds[e][0]]][Case.Perm[EdgeEnds[e][1]]];
+			Slot[M01 + e] = (uint32)EdgeSplitVertex[FEMComponent->TetEdgeIndices[6 * TetIndex + Local]];
+		}
+	}
 
-			uint32 NewIndexM01;
-			uint32 NewIndexM02;
-			uint32 NewIndexM03;
+	Out.Num = Template.NumTets;
+	for (int k = 0; k < Template.NumTets; ++k)
+	{
+		const uint8* T = Template.Tets[k];
+		Out.Tets[k] = FIntVector4(Slot[T[0]], Slot[T[1]], Slot[T[2]], Slot[T[3]]);
+		Out.Regions[k] = Labels[Slot[Template.Owner[k]]];
+	}
 
-			{
-				std::unique_lock<std::shared_mutex> lock(vertexMutex);
-				NewIndexM01 = NumVertices++;
-				NewIndexM02 = NumVertices++;
-				NewIndexM03 = NumVertices++;
-
-				VerticesToAdd.Emplace(M01);
-				VerticesToAdd.Emplace(M02);
-				VerticesToAdd.Emplace(M03);
-			}
+	return Out.Num;
+}
 
-			Result.FindOrAdd(key1).Emplace(FIntVector4(t[0], NewIndexM01, NewIndexM02, NewIndexM03));
-			Result.FindOrAdd(key2).Emplace(FIntVector4(NewIndexM01, t[1], t[2], t[3]));
-			Result.FindOrAdd(key2).Emplace(FIntVector4(NewIndexM02, NewIndexM01, t[2], t[3]));
-			Result.FindOrAdd(key2).Emplace(FIntVector4(NewIndexM03, NewIndexM01, NewIndexM02, t[3]));
-		}
+// 렌더 메쉬 표면 삼각형 중 세 정점이 같은 영역인 것을 영역별로 수집 (사면체 정점 인덱스, 렌더 메쉬 winding 유지)
+void SplitMesh::CollectSurfaceTriangles(TMap<uint32, TArray<int32>>& Triangles) const
+{
+	// 렌더 버텍스 → 사면체 정점 대응은 사면체 메쉬 생성 시 계산됨
+	const TArray<int32>& link = FEMComponent->RenderToTetVertex;
 
-	}
-	else if (Sources.Num() == 3)
+	for (int32 i = 0; i < IndexBuffer->GetNumIndices(); i += 3)
 	{
-		auto Source1 = Sources.begin();
-		auto& Source2 = ++Sources.begin();
-		auto& Source3 = ++(++Sources.begin());
-		FIntVector4 t;
-		uint32 key1, key2, key3;
+		TArray<int32> Index;
 
-		if (Source1.Value().Num() == Source2.Value().Num())
+		for (int j = 0; j < 3; ++j)
 		{
-			t = FIntVector4(Source1.Value()[0], Source2.Value()[0], Source3.Value()[0], Source3.Value()[1]);
-			key1 = Source1.Key();
-			key2 = Source2.Key();
-			key3 = Source3.Key();
+			int32 idx = (int32)IndexBuffer->GetIndex(i + j);
+			Index.Emplace(link.IsValidIndex(idx) ? link[idx] : INDEX_NONE);
 		}
-		else if (Source1.Value().Num() == Source3.Value().Num())
+
+		// 사면체 정점과 대응되지 않는 삼각형은 제외
+		if (Index.Contains(INDEX_NONE))
 		{
-			t = FIntVector4(Source1.Value()[0], Source3.Value()[0], Source2.Value()[0], Source2.Value()[1]);
-			key1 = Source1.Key();
-			key2 = Source3.Key();
-			key3 = Source2.Key();
+			continue;
 		}
-		else
+
+		if (Labels[Index[0]] == Labels[Index[1]] &&
+			Labels[Index[1]] == Labels[Index[2]])
 		{
-			t = FIntVector4(Source2.Value()[0], Source3.Value()[0], Source1.Value()[0], Source1.Value()[1]);
-			key1 = Source2.Key();
-			key2 = Source3.Key();
-			key3 = Source1.Key();
+			Triangles.FindOrAdd(Labels[Index[0]]).Append(Index);
+			//UE_LOG(LogTemp, Log, TEXT("%d: [%d, %d, %d]"), Labels[Index[0]], Index[0], Index[1], Index[2]);
 		}
+	}
+}
+
+// 절단 에지마다 분리 정점 할당
+// 청크별 개수를 세고 prefix sum으로 최종 인덱스를 정하므로 잠금 불필요
+void SplitMesh::AllocateSplitVertices()
+{
+	const int32 NumTetVertices = FEMComponent->TetMeshVertices.Num();
+	const int32 NumWorkers = FMath::Max(FTaskGraphInterface::Get().GetNumWorkerThreads(), 1);
 
-		FVector3f M01 = CalculateSplitPoint(t[0], t[1]);
-		FVector3f M02 = CalculateSplitPoint(t[0], t[2]);
-		FVector3f M03 = CalculateSplitPoint(t[0], t[3]);
-		FVector3f M12 = CalculateSplitPoint(t[1], t[2]);
-		FVector3f M13 = CalculateSplitPoint(t[1], t[3]);
+	const TArray<FIntPoint>& Edges = FEMComponent->TetEdges;
+	const int32 NumEdges = Edges.Num();
+	const int32 NumChunks = FMath::Clamp(NumWorkers * 4, 1, FMath::Max(NumEdges, 1));
+	const int32 ChunkSize = FMath::DivideAndRoundUp(NumEdges, NumChunks);
 
-		uint32 NewIndexM01;
-		uint32 NewIndexM02;
-		uint32 NewIndexM03;
-		uint32 NewIndexM12;
-		uint32 NewIndexM13;
+	TArray<int32> ChunkOffset;
+	ChunkOffset.Init(0, NumChunks + 1);
+	EdgeSplitVertex.SetNumUninitialized(NumEdges);
 
+	ParallelFor(NumChunks, [&](int32 ChunkIndex)
 		{
-			std::unique_lock<std::shared_mutex> lock(vertexMutex);
-			NewIndexM01 = NumVertices++;
-			NewIndexM02 = NumVertices++;
-			NewIndexM03 = NumVertices++;
-			NewIndexM12 = NumVertices++;
-			NewIndexM13 = NumVertices++;
-
-			VerticesToAdd.Emplace(M01);
-			VerticesToAdd.Emplace(M02);
-			VerticesToAdd.Emplace(M03);
-			VerticesToAdd.Emplace(M12);
-			VerticesToAdd.Emplace(M13);
-		}
+			const int32 Begin = ChunkIndex * ChunkSize;
+			const int32 End = FMath::Min(Begin + ChunkSize, NumEdges);
+			int32 Count = 0;
+			for (int32 e = Begin; e < End; ++e)
+			{
+				EdgeSplitVertex[e] = Labels[Edges[e].X] != Labels[Edges[e].Y] ? Count++ : INDEX_NONE;
+			}
+			ChunkOffset[ChunkIndex + 1] = Count;
+		});
 
-		Result.FindOrAdd(key1).Emplace(FIntVector4(t[0], NewIndexM01, NewIndexM02, NewIndexM03));
-		Result.FindOrAdd(key1).Emplace(FIntVector4(NewIndexM02, NewIndexM03, NewIndexM01, NewIndexM13));
-		Result.FindOrAdd(key2).Emplace(FIntVector4(t[1], NewIndexM12, NewIndexM13, NewIndexM01));
-		Result.FindOrAdd(key2).Emplace(FIntVector4(NewIndexM12, NewIndexM13, NewIndexM01, NewIndexM02));
-		Result.FindOrAdd(key3).Emplace(FIntVector4(NewIndexM12, t[2], NewIndexM13, NewIndexM02));
-		Result.FindOrAdd(key3).Emplace(FIntVector4(t[2], t[3], NewIndexM13, NewIndexM02));
-		Result.FindOrAdd(key3).Emplace(FIntVector4(NewIndexM13, t[3], NewIndexM03, NewIndexM02));
-	}
-	else
+	for (int32 c = 0; c < NumChunks; ++c)
 	{
-		auto Source1 = Sources.begin();
-		auto& Source2 = ++Sources.begin();
-		auto& Source3 = ++(++Sources.begin());
-		auto& Source4 = ++(++(++Sources.begin()));
-
-		FVector3f M01 = CalculateSplitPoint(tetra[0], tetra[1]);
-		FVector3f M02 = CalculateSplitPoint(tetra[0], tetra[2]);
-		FVector3f M03 = CalculateSplitPoint(tetra[0], tetra[3]);
-		FVector3f M12 = CalculateSplitPoint(tetra[1], tetra[2]);
-		FVector3f M13 = CalculateSplitPoint(tetra[1], tetra[3]);
-		FVector3f M23 = CalculateSplitPoint(tetra[2], tetra[3]);
-
-		uint32 NewIndexM01;
-		uint32 NewIndexM02;
-		uint32 NewIndexM03;
-		uint32 NewIndexM12;
-		uint32 NewIndexM13;
-		uint32 NewIndexM23;
+		ChunkOffset[c + 1] += ChunkOffset[c];
+	}
 
+	VerticesToAdd.SetNumUninitialized(ChunkOffset[NumChunks]);
+	NumVertices = NumTetVertices + ChunkOffset[NumChunks];
+
+	// TetEdges는 정렬된 정점 쌍이므로 분리 위치는 호출 순서와 무관
+	ParallelFor(NumChunks, [&](int32 ChunkIndex)
 		{
-			std::unique_lock<std::shared_mutex> lock(vertexMutex);
-			NewIndexM01 = NumVertices++;
-			NewIndexM02 = NumVertices++;
-			NewIndexM03 = NumVertices++;
-			NewIndexM12 = NumVertices++;
-			NewIndexM13 = NumVertices++;
-			NewIndexM23 = NumVertices++;
-
-			VerticesToAdd.Emplace(M01);
-			VerticesToAdd.Emplace(M02);
-			VerticesToAdd.Emplace(M03);
-			VerticesToAdd.Emplace(M12);
-			VerticesToAdd.Emplace(M13);
-			VerticesToAdd.Emplace(M23);
-		}
+			const int32 Begin = ChunkIndex * ChunkSize;
+			const int32 End = FMath::Min(Begin + ChunkSize, NumEdges);
+			for (int32 e = Begin; e < End; ++e)
+			{
+				if (EdgeSplitVertex[e] != INDEX_NONE)
+				{
+					const int32 Local = ChunkOffset[ChunkIndex] + EdgeSplitVertex[e];
+					VerticesToAdd[Local] = CalculateSplitPoint(Edges[e].X, Edges[e].Y);
+					EdgeSplitVertex[e] = NumTetVertices + Local;
+				}
+			}
+		});
+}
 
-		Result.FindOrAdd(Source1.Key()).Emplace(FIntVector4(tetra[0], NewIndexM01, NewIndexM02, NewIndexM03));
-		Result.FindOrAdd(Source1.Key()).Emplace(FIntVector4(NewIndexM02, NewIndexM03, NewIndexM01, NewIndexM13));
-		Result.FindOrAdd(Source2.Key()).Emplace(FIntVector4(tetra[1], NewIndexM12, NewIndexM13, NewIndexM01));
-		Result.FindOrAdd(Source2.Key()).Emplace(FIntVector4(NewIndexM12, NewIndexM13, NewIndexM02, NewIndexM01));
-		Result.FindOrAdd(Source3.Key()).Emplace(FIntVector4(tetra[2], NewIndexM23, NewIndexM12, NewIndexM02));
-		Result.FindOrAdd(Source3.Key()).Emplace(FIntVector4(NewIndexM23, NewIndexM13, NewIndexM02, NewIndexM12));
-		Result.FindOrAdd(Source4.Key()).Emplace(FIntVector4(tetra[3], NewIndexM13, NewIndexM23, NewIndexM03));
-		Result.FindOrAdd(Source4.Key()).Emplace(FIntVector4(NewIndexM13, NewIndexM23, NewIndexM03, NewIndexM02));
-	}
+// 청크 단위로 사면체를 나누어 각 청크 전용 버퍼에 기록한 뒤 영역별로 모음
+void SplitMesh::GatherRegionTets(TFunctionRef<void(int32, FSplitTetOutput&)> SplitOne, TArray<uint32>& SeedArray, TMap<uint32, TArray<FIntVector4>>& TetMeshes) const
+{
+	const int32 NumWorkers = FMath::Max(FTaskGraphInterface::Get().GetNumWorkerThreads(), 1);
+
+	const int32 NumTets = Tets->Num();
+	const int32 NumTetChunks = FMath::Clamp(NumWorkers * 4, 1, FMath::Max(NumTets, 1));
+	const int32 TetChunkSize = FMath::DivideAndRoundUp(NumTets, NumTetChunks);
 
-	TArray<uint32> s;
-	Sources.GenerateKeyArray(s);
+	struct FChunkOutput
 	{
-		std::unique_lock<std::shared_mutex> lock(seedMutex);
-		Seed.Append(s);
-	}
+		TArray<FIntVector4> Tets;
+		TArray<uint32> Regions;
+		TArray<uint32, TInlineAllocator<16>> SeenRegions;
+		TArray<int32, TInlineAllocator<16>> RegionCount;
+	};
+	TArray<FChunkOutput> ChunkOutputs;
+	ChunkOutputs.SetNum(NumTetChunks);
+
+	ParallelFor(NumTetChunks, [&](int32 ChunkIndex)
+		{
+			if (IsCancelled())
+				return;
 
-	return Result;
-}
+			FChunkOutput& Output = ChunkOutputs[ChunkIndex];
+			const int32 Begin = ChunkIndex * TetChunkSize;
+			const int32 End = FMath::Min(Begin + TetChunkSize, NumTets);
+			Output.Tets.Reserve(End - Begin);
+			Output.Regions.Reserve(End - Begin);
+
+			FSplitTetOutput Out;
+			for (int32 i = Begin; i < End; ++i)
+			{
+				SplitOne(i, Out);
+				for (int32 k = 0; k < Out.Num; ++k)
+				{
+					Output.Tets.Emplace(Out.Tets[k]);
+					Output.Regions.Emplace(Out.Regions[k]);
+					Output.SeenRegions.AddUnique(Out.Regions[k]);
+				}
+			}
+		});
 
-void SplitMesh::GenerateCombinations(const TArray<int32>& InputArray, TArray<int32>& CurrentCombination, int32 StartIndex, int32 CombinationSize, TArray<TArray<int32>>& Result) {
-	if (CurrentCombination.Num() == CombinationSize) {
-		Result.Add(CurrentCombination);
+	if (IsCancelled())
 		return;
-	}
 
-	for (int32 i = StartIndex; i < InputArray.Num(); i++) {
-		CurrentCombination.Add(InputArray[i]);
-		GenerateCombinations(InputArray, CurrentCombination, i + 1, CombinationSize, Result);
-		CurrentCombination.Pop();
+	TSet<uint32> Seed;
+	for (const FChunkOutput& Output : ChunkOutputs)
+	{
+		Seed.Append(Output.SeenRegions);
 	}
-}
 
-// 사면체에서 메쉬를 분리하고 새 메쉬 반환
-TMap<uint32, UProceduralMeshComponent*> SplitMesh::Split()
-{
-	TMap<uint32, UProceduralMeshComponent*> Meshes;
-	TMap<uint32, TArray<FIntVector4>> TetMeshes;
-	TMap<uint32, TArray<FVector>> Vertices;
-	TMap<uint32, TArray<int32>> Triangles;
-	TMap<uint32, TArray<TArray<int32>>> TriangleDupCheck;
-	int32 count = 0;
+	SeedArray = Seed.Array();
+	SeedArray.Sort();
+	const int32 NumRegions = SeedArray.Num();
 
-	TMap<uint32, uint32> link;
-	for (int32 i = 0; i < (int32)PositionVertexBuffer->GetNumVertices(); ++i)
-	{
-		FVector3f pos = PositionVertexBuffer->VertexPosition(i);
-		for (int32 j = 0; j < FEMComponent->TetMeshVertices.Num(); ++j)
+	// 영역별 개수의 prefix sum으로 각 청크가 쓸 위치를 정한 뒤 병렬로 복사
+	ParallelFor(NumTetChunks, [&](int32 ChunkIndex)
 		{
-			if ((FEMComponent->TetMeshVertices[j] - (FVector)pos).IsNearlyZero())
+			FChunkOutput& Output = ChunkOutputs[ChunkIndex];
+			Output.RegionCount.Init(0, NumRegions);
+			for (uint32& Region : Output.Regions)
 			{
-				link.Emplace(i, j);
-				break;
+				// 라벨을 SeedArray 인덱스로 변환
+				Region = (uint32)Algo::LowerBound(SeedArray, Region);
+				Output.RegionCount[Region]++;
 			}
-		}
-	}
+		});
 
-	// 기존 버텍스 추가
-	for (int32 i = 0; i < IndexBuffer->GetNumIndices(); i += 3)
+	TArray<TArray<FIntVector4>*> RegionTets;
+	TArray<int32> ChunkRegionOffset;
+	ChunkRegionOffset.SetNumUninitialized(NumTetChunks * NumRegions);
+	for (int32 r = 0; r < NumRegions; ++r)
 	{
-		TArray<int32> Index;
+		int32 Offset = 0;
+		for (int32 c = 0; c < NumTetChunks; ++c)
+		{
+			ChunkRegionOffset[c * NumRegions + r] = Offset;
+			Offset += ChunkOutputs[c].RegionCount[r];
+		}
+		TArray<FIntVector4>& Region = TetMeshes.FindOrAdd(SeedArray[r]);
+		Region.SetNumUninitialized(Offset);
+		RegionTets.Emplace(&Region);
+	}
 
-		for (int j = 0; j < 3; ++j)
+	ParallelFor(NumTetChunks, [&](int32 ChunkIndex)
 		{
-			int32 idx = (int32)IndexBuffer->GetIndex(i + j);
-			FVector vtx = FVector(PositionVertexBuffer->VertexPosition(idx));
+			const FChunkOutput& Output = ChunkOutputs[ChunkIndex];
+			int32* Cursor = &ChunkRegionOffset[ChunkIndex * NumRegions];
+			for (int32 k = 0; k < Output.Tets.Num(); ++k)
+			{
+				const uint32 Region = Output.Regions[k];
+				(*RegionTets[Region])[Cursor[Region]++] = Output.Tets[k];
+			}
+		});
+}
+
+FVector SplitMesh::GetVertexPosition(const int32 GlobalIndex) const
+{
+	const int32 NumTetVertices = FEMComponent->TetMeshVertices.Num();
+	return GlobalIndex < NumTetVertices
+		? FEMComponent->TetMeshVertices[GlobalIndex]
+		: FVector(VerticesToAdd[GlobalIndex - NumTetVertices]);
+}
+
+// 영역 사면체들의 부피, 질량 중심, 관성 텐서
+// 사면체 하나의 2차 모멘트: ∫x xᵀ dV = V/20 * (Σ pᵢpᵢᵀ + s sᵀ), s = Σ pᵢ
+// 관성 텐서: I = tr(C)·E - C, C는 질량 중심 기준 2차 모멘트
+FFragmentMassProperties SplitMesh::ComputeMassProperties(const TArray<FIntVector4>& RegionTets) const
+{
+	FFragmentMassProperties Result;
+
+	double Volume = 0.0;
+	FVector FirstMoment = FVector::ZeroVector;
+	Eigen::Matrix3d SecondMoment = Eigen::Matrix3d::Zero();
 
-			Index.Emplace(link.FindRef(idx));
-			Vertices.FindOrAdd(Distance->FindRef(link.FindRef(idx)).Source).Emplace(vtx);
+	for (const FIntVector4& Tet : RegionTets)
+	{
+		FVector P[4];
+		for (int i = 0; i < 4; ++i)
+		{
+			P[i] = GetVertexPosition(Tet[i]);
 		}
 
-		if (Distance->FindRef(Index[0]).Source == Distance->FindRef(Index[1]).Source &&
-			Distance->FindRef(Index[1]).Source == Distance->FindRef(Index[2]).Source)
+		const double TetVolume = FMath::Abs(FVector::DotProduct(P[1] - P[0], FVector::CrossProduct(P[2] - P[0], P[3] - P[0]))) / 6.0;
+		if (TetVolume <= UE_DOUBLE_SMALL_NUMBER)
 		{
-			Triangles.FindOrAdd(Distance->FindRef(Index[0]).Source).Append(Index);
-			//UE_LOG(LogTemp, Log, TEXT("%d: [%d, %d, %d]"), Distance->FindRef(Index[0]).Source, Index[0], Index[1], Index[2]);
+			continue;
 		}
-	}
 
-	TArray<TFuture<void>> Futures;
+		const FVector Sum = P[0] + P[1] + P[2] + P[3];
+		Volume += TetVolume;
+		FirstMoment += TetVolume * Sum / 4.0;
 
-	for (int32 i = 0; i < Tets->Num(); ++i)
-	{
-		Futures.Add(Async(EAsyncExecution::ThreadPool, [&, i]()
+		for (int a = 0; a < 3; ++a)
+		{
+			for (int b = 0; b < 3; ++b)
 			{
-				auto result = SplitTetra((*Tets)[i]);
+				double Outer = Sum[a] * Sum[b];
+				for (int i = 0; i < 4; ++i)
 				{
-					std::unique_lock<std::shared_mutex> lock(tetMutex);
-					for (auto& r : result)
-					{
-						TetMeshes.FindOrAdd(r.Key).Append(r.Value);
-					}
+					Outer += P[i][a] * P[i][b];
 				}
-			}));
+				SecondMoment(a, b) += TetVolume / 20.0 * Outer;
+			}
+		}
 	}
 
-	for (auto& Future : Futures)
+	if (Volume <= UE_DOUBLE_SMALL_NUMBER)
 	{
-		Future.Wait();
+		return Result;
 	}
 
-	auto SeedArray = Seed.Array();
-	SeedArray.Sort();
+	const FVector CenterOfMass = FirstMoment / Volume;
+	const Eigen::Vector3d Com(CenterOfMass.X, CenterOfMass.Y, CenterOfMass.Z);
+	const Eigen::Matrix3d Covariance = SecondMoment - Volume * Com * Com.transpose();
+	const Eigen::Matrix3d Inertia = Covariance.trace() * Eigen::Matrix3d::Identity() - Covariance;
 
-	// 새로운 메쉬 선언
-	for (int i = 0; i < SeedArray.Num(); ++i)
+	Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> Solver(Inertia);
+	const Eigen::Vector3d Moments = Solver.eigenvalues();
+	Eigen::Matrix3d Axes = Solver.eigenvectors();
+	if (Axes.determinant() < 0)
 	{
-		Meshes.FindOrAdd(SeedArray[i]) = NewObject<UProceduralMeshComponent>();
+		Axes.col(2) = -Axes.col(2);
 	}
 
+	const FMatrix Basis(
+		FVector(Axes(0, 0), Axes(1, 0), Axes(2, 0)),
+		FVector(Axes(0, 1), Axes(1, 1), Axes(2, 1)),
+		FVector(Axes(0, 2), Axes(1, 2), Axes(2, 2)),
+		FVector::ZeroVector);
+
+	Result.Volume = Volume;
+	Result.CenterOfMass = CenterOfMass;
+	Result.PrincipalInertia = FVector(FMath::Max(Moments(0), 0.0), FMath::Max(Moments(1), 0.0), FMath::Max(Moments(2), 0.0));
+	Result.PrincipalRotation = FQuat(Basis);
+	return Result;
+}
 
-	for (int32 i = 0; i < SeedArray.Num(); ++i)
+// 영역별 경계면을 추출해 영역별 정점/삼각형 배열 생성
+void SplitMesh::ExtractRegionSurfaces(const TArray<uint32>& SeedArray, const TMap<uint32, TArray<FIntVector4>>& TetMeshes, TMap<uint32, TArray<int32>>& Triangles, TMap<uint32, TArray<FVector>>& Vertices) const
+{
+	const int32 NumTetVertices = FEMComponent->TetMeshVertices.Num();
+
+	for (int i = 0; i < SeedArray.Num(); ++i)
 	{
-		for (int32 j = 0; j < Triangles.FindRef(SeedArray[i]).Num(); j += 3)
-		{
-			TriangleDupCheck.FindOrAdd(SeedArray[i]).Emplace(TArray({ Triangles.FindRef(SeedArray[i])[j], Triangles.FindRef(SeedArray[i])[j + 1], Triangles.FindRef(SeedArray[i])[j + 2] }));
-		}
 		Vertices.FindOrAdd(SeedArray[i]);
-		TriangleDupCheck.FindOrAdd(SeedArray[i]);
 		Triangles.FindOrAdd(SeedArray[i]);
 	}
 
-	TArray<int32> arr({ 0, 1, 2, 3 });
-	TArray<TArray<int32>> AllCombinations;
-	TArray<int32> CurrentCombination;
-	GenerateCombinations(arr, CurrentCombination, 0, 3, AllCombinations);
+	// 사면체의 4개 면 (정점 3개 조합)
+	static constexpr int32 TetFaces[4][3] = { { 0, 1, 2 }, { 0, 1, 3 }, { 0, 2, 3 }, { 1, 2, 3 } };
 
-	Futures.Empty();
-	
+	const int32 NumAllVertices = (int32)NumVertices;
+
+	// 영역마다 경계면 추출. 맵은 루프 전에 모두 추가되었으므로 각 작업은 자기 값만 수정
 	ParallelFor(SeedArray.Num(), [&](int32 Index)
 		{
+			if (IsCancelled())
+				return;
+
 			uint32 MeshKey = SeedArray[Index];
-			TArray<FIntVector4>& TetValue = TetMeshes[MeshKey];
+			const TArray<FIntVector4>* TetValue = TetMeshes.Find(MeshKey);
 
-			TArray<FVector>& VertexArray = Vertices.FindOrAdd(MeshKey);
-			TArray<int32>& TriangleArray = Triangles.FindOrAdd(MeshKey);
-			TArray<TArray<int32>>& TriangleDup = TriangleDupCheck.FindOrAdd(MeshKey);
+			TArray<FVector>& VertexArray = Vertices[MeshKey];
+			TArray<int32>& TriangleArray = Triangles[MeshKey];
 
-			for (auto& t : TetValue)
-			{
-				FVector3d Center = FVector3d(0.0, 0.0, 0.0);
-				TArray<int32> PosIndices;
-				TArray<FVector3d> Pos;
+			// 전역 정점 인덱스 → 위치 용접된 로컬 정점 인덱스
+			TArray<int32> Remap;
+			Remap.Init(INDEX_NONE, NumAllVertices);
+			TMap<FVector, int32> PositionToLocal;
+			TArray<FVector> LocalPositions;
 
-				for (int i = 0; i < 4; ++i)
+			auto GetLocalIndex = [&](int32 GlobalIndex)
+			{
+				int32& Local = Remap[GlobalIndex];
+				if (Local == INDEX_NONE)
 				{
-					FVector VertexPos;
-					if (t[i] < FEMComponent->TetMeshVertices.Num())
+					const FVector VertexPos = GlobalIndex < NumTetVertices
+						? FEMComponent->TetMeshVertices[GlobalIndex]
+						: FVector(VerticesToAdd[GlobalIndex - NumTetVertices]);
+
+					if (const int32* Found = PositionToLocal.Find(VertexPos))
 					{
-						VertexPos = FVector(FEMComponent->TetMeshVertices[t[i]]);
+						Local = *Found;
 					}
 					else
 					{
-						VertexPos = FVector(VerticesToAdd[t[i] - FEMComponent->TetMeshVertices.Num()]);
+						Local = LocalPositions.Emplace(VertexPos);
+						PositionToLocal.Emplace(VertexPos, Local);
 					}
+				}
+				return Local;
+			};
+
+			// 정렬된 정점 인덱스를 키로 면을 저장. 같은 면이 다시 나오면 내부 면이므로 토글
+			TMap<FIntVector, int32> FaceSlot;
+			TArray<FIntVector> Faces;
+			TArray<bool> FaceAlive;
+			TArray<bool> FaceSurface;
 
-					int32 VertexIndex;
-					if (!VertexArray.Find(VertexPos, VertexIndex))
+			auto FaceKey = [](int32 A, int32 B, int32 C)
+			{
+				if (A > B) Swap(A, B);
+				if (B > C) Swap(B, C);
+				if (A > B) Swap(A, B);
+				return FIntVector(A, B, C);
+			};
+
+			auto AddFace = [&](const FIntVector& Face, bool bSurface)
+			{
+				const FIntVector Key = FaceKey(Face.X, Face.Y, Face.Z);
+				if (int32* Slot = FaceSlot.Find(Key))
+				{
+					// 표면 삼각형이 같은 사면체 면보다 우선
+					if (!FaceSurface[*Slot])
 					{
-						VertexIndex = VertexArray.Num();
-						VertexArray.Emplace(VertexPos);
+						FaceAlive[*Slot] = !FaceAlive[*Slot];
 					}
-
-					PosIndices.Emplace(VertexIndex);
-					Pos.Emplace(VertexPos);
-					Center += FVector3d(VertexPos);
+					return;
 				}
-
-				Center /= 4;
-
-				for (auto& Comb : AllCombinations)
+				FaceSlot.Emplace(Key, Faces.Num());
+				Faces.Emplace(Face);
+				FaceAlive.Emplace(true);
+				FaceSurface.Emplace(bSurface);
+			};
+
+			const TArray<int32>& SurfaceTriangles = Triangles[MeshKey];
+			for (int32 i = 0; i + 2 < SurfaceTriangles.Num(); i += 3)
+			{
+				const int32 A = GetLocalIndex(SurfaceTriangles[i]);
+				const int32 B = GetLocalIndex(SurfaceTriangles[i + 1]);
+				const int32 C = GetLocalIndex(SurfaceTriangles[i + 2]);
+				if (A != B && B != C && A != C)
 				{
-					auto normal = FVector::CrossProduct(Pos[Comb[1]] - Pos[Comb[0]], Pos[Comb[2]] - Pos[Comb[0]]);
-					auto isFacing = FVector::DotProduct(normal, Center - Pos[Comb[0]]);
+					AddFace(FIntVector(A, B, C), true);
+				}
+			}
 
-					TArray<int32> Indices;
+			if (TetValue)
+			{
+				FaceSlot.Reserve(FaceSlot.Num() + TetValue->Num() * 2);
+				for (const FIntVector4& t : *TetValue)
+				{
+					int32 PosIndices[4];
+					FVector3d Center = FVector3d(0.0, 0.0, 0.0);
 
-					if (isFacing > 0)
+					for (int i = 0; i < 4; ++i)
 					{
-						Indices = { PosIndices[Comb[0]], PosIndices[Comb[1]], PosIndices[Comb[2]] };
-					}
-					else
-					{
-						Indices = { PosIndices[Comb[2]], PosIndices[Comb[1]], PosIndices[Comb[0]] };
+						PosIndices[i] = GetLocalIndex(t[i]);
+						Center += LocalPositions[PosIndices[i]];
 					}
 
-					int32 idx;
+					Center /= 4;
 
-					if (!TriangleDup.Find(TArray({ Indices[2], Indices[1], Indices[0] }), idx))
+					for (const int32(&Comb)[3] : TetFaces)
 					{
-						TriangleArray.Append(Indices);
-						TriangleDup.Emplace(Indices);
-					}
-					else
-					{
-						for (int i = 0; i < 3; ++i)
+						const int32 I0 = PosIndices[Comb[0]];
+						const int32 I1 = PosIndices[Comb[1]];
+						const int32 I2 = PosIndices[Comb[2]];
+
+						// 용접으로 퇴화된 면은 무시
+						if (I0 == I1 || I1 == I2 || I0 == I2)
 						{
-							TriangleArray.RemoveAt(3 * idx);
+							continue;
 						}
-						TriangleDup.RemoveAt(idx);
+
+						const FVector& P0 = LocalPositions[I0];
+						auto normal = FVector::CrossProduct(LocalPositions[I1] - P0, LocalPositions[I2] - P0);
+						auto isFacing = FVector::DotProduct(normal, Center - P0);
+
+						AddFace(isFacing > 0 ? FIntVector(I0, I1, I2) : FIntVector(I2, I1, I0), false);
 					}
 				}
 			}
-			count++;
+
+			// 남은 경계면과 실제 사용되는 정점만 한 번에 출력
+			TArray<int32> Compact;
+			Compact.Init(INDEX_NONE, LocalPositions.Num());
+			VertexArray.Reset();
+			TriangleArray.Reset();
+
+			for (int32 f = 0; f < Faces.Num(); ++f)
+			{
+				if (!FaceAlive[f])
+				{
+					continue;
+				}
+				for (int32 c = 0; c < 3; ++c)
+				{
+					int32& Out = Compact[Faces[f][c]];
+					if (Out == INDEX_NONE)
+					{
+						Out = VertexArray.Emplace(LocalPositions[Faces[f][c]]);
+					}
+					TriangleArray.Emplace(Out);
+				}
+			}
 		}
 	);
+}
 
-	while (count < SeedArray.Num());
-
-	//FString VerticesLog;
-	//for (const FVector3f& Vertex : VerticesToAdd)
-	//{
-	//	VerticesLog += FString::Printf(TEXT("(%f, %f, %f), "), Vertex.X, Vertex.Y, Vertex.Z);
-	//}
+// 사면체 분리부터 영역별 경계면 추출까지
+void SplitMesh::BuildRegions(const bool bTetGranular, TArray<uint32>& SeedArray, TMap<uint32, TArray<int32>>& Triangles, TMap<uint32, TArray<FVector>>& Vertices)
+{
+	TMap<uint32, TArray<FIntVector4>> TetMeshes;
 
-	//if (VerticesLog.Len() > 2)
-	//{
-	//	VerticesLog.LeftChopInline(2);
-	//}
+	if (bTetGranular)
+	{
+		// 사면체 경계면을 그대로 조각 경계로 사용
+		// 표면 삼각형도 사면체 면에서 추출하므로 렌더 메쉬 삼각형은 사용하지 않음
+		NumVertices = FEMComponent->TetMeshVertices.Num();
+		VerticesToAdd.Reset();
+		GatherRegionTets([this](int32 TetIndex, FSplitTetOutput& Out) { AssignTet(TetIndex, Out); }, SeedArray, TetMeshes);
+	}
+	else
+	{
+		CollectSurfaceTriangles(Triangles);
+		AllocateSplitVertices();
+		GatherRegionTets([this](int32 TetIndex, FSplitTetOutput& Out) { SplitTetra(TetIndex, Out); }, SeedArray, TetMeshes);
+	}
 
-	//UE_LOG(LogTemp, Log, TEXT("VerticesToAdd: [%s]"), *VerticesLog);
+	// 취소되면 SeedArray를 비워 이후 단계가 아무것도 만들지 않게 함
+	if (!IsCancelled())
+		ExtractRegionSurfaces(SeedArray, TetMeshes, Triangles, Vertices);
+	if (IsCancelled())
+	{
+		SeedArray.Reset();
+		return;
+	}
 
+	// 영역별 질량 특성. 물리 쿠킹 결과 대신 사면체에서 직접 계산
+	MassProperties.Reset();
+	for (const uint32 MeshKey : SeedArray)
+	{
+		MassProperties.FindOrAdd(MeshKey);
+	}
+	ParallelFor(SeedArray.Num(), [&](int32 Index)
+		{
+			if (const TArray<FIntVector4>* RegionTets = TetMeshes.Find(SeedArray[Index]))
+			{
+				MassProperties[SeedArray[Index]] = ComputeMassProperties(*RegionTets);
+			}
+		});
 
 	if (SeedArray.Num() == 0)
 	{
@@ -473,6 +848,31 @@ TMap<uint32, UProceduralMeshComponent*> SplitMesh::Split()
 	}
 
 	UE_LOG(LogTemp, Log, TEXT("Seed: %s"), *ArrayString);
+}
+
+// 영역별 UProceduralMeshComponent 생성
+TMap<uint32, UProceduralMeshComponent*> SplitMesh::BuildRegionMeshes(const TArray<uint32>& SeedArray, const TMap<uint32, TArray<int32>>& Triangles, const TMap<uint32, TArray<FVector>>& Vertices)
+{
+	TMap<uint32, UProceduralMeshComponent*> Meshes;
+
+	// 새로운 메쉬 선언
+	Collisions.Reset();
+	for (int i = 0; i < SeedArray.Num(); ++i)
+	{
+		Meshes.FindOrAdd(SeedArray[i]) = NewObject<UProceduralMeshComponent>();
+		Collisions.FindOrAdd(SeedArray[i]);
+	}
+
+	// 충돌 형상은 워커 스레드에서 계산하고, 쿠킹은 액터에 한 번만 맡김
+	ParallelFor(SeedArray.Num(), [&](int32 Index)
+		{
+			const uint32 MeshKey = SeedArray[Index];
+			if (const TArray<FVector>* VertexArray = Vertices.Find(MeshKey))
+			{
+				Collisions[MeshKey] = ComputeCollision(*VertexArray, MassProperties.FindRef(MeshKey));
+			}
+		});
+
 	// 새 메쉬 추가
 	for (int idx = 0; idx < SeedArray.Num(); ++idx)
 	{
@@ -490,7 +890,6 @@ TMap<uint32, UProceduralMeshComponent*> SplitMesh::Split()
 				TArray<FProcMeshTangent>(),
 				true
 			);
-			Meshes[Index]->AddCollisionConvexMesh(Vertices.FindRef(Index));
 			UE_LOG(LogTemp, Log, TEXT("Vertex %d, Triangle %d"), Vertices.FindRef(Index).Num(), Triangles.FindRef(Index).Num());
 		}
 		else
@@ -500,4 +899,142 @@ TMap<uint32, UProceduralMeshComponent*> SplitMesh::Split()
 	}
 
 	return Meshes;
-}
\ No newline at end of file
+}
+
+// 영역별 FDynamicMesh3 조각 생성. 조각마다 독립적이므로 메쉬 구성과 노멀 계산을 병렬로 수행
+TArray<FFragment> SplitMesh::BuildFragments(const TArray<uint32>& SeedArray, const TMap<uint32, TArray<int32>>& Triangles, const TMap<uint32, TArray<FVector>>& Vertices) const
+{
+	TArray<FFragment> Fragments;
+	Fragments.SetNum(SeedArray.Num());
+
+	std::atomic<int32> NumNonManifold(0);
+	std::atomic<int32> NumDropped(0);
+
+	ParallelFor(SeedArray.Num(), [&](int32 Index)
+		{
+			if (IsCancelled())
+				return;
+
+			const uint32 MeshKey = SeedArray[Index];
+			const TArray<FVector>& VertexArray = Vertices.FindChecked(MeshKey);
+			const TArray<int32>& TriangleArray = Triangles.FindChecked(MeshKey);
+
+			FFragment& Fragment = Fragments[Index];
+			Fragment.Region = MeshKey;
+
+			UE::Geometry::FDynamicMesh3& DynamicMesh = Fragment.Mesh;
+			for (const FVector& Vertex : VertexArray)
+			{
+				DynamicMesh.AppendVertex(Vertex);
+			}
+			for (int32 i = 0; i + 2 < TriangleArray.Num(); i += 3)
+			{
+				const UE::Geometry::FIndex3i Tri(TriangleArray[i], TriangleArray[i + 1], TriangleArray[i + 2]);
+				const int32 TriangleID = DynamicMesh.AppendTriangle(Tri);
+				if (TriangleID == UE::Geometry::FDynamicMesh3::NonManifoldID)
+				{
+					// 비다양체 에지: 정점을 복제해 독립된 삼각형으로 추가해 구멍이 생기지 않게 함
+					const UE::Geometry::FIndex3i Copy(
+						DynamicMesh.AppendVertex(DynamicMesh.GetVertex(Tri.A)),
+						DynamicMesh.AppendVertex(DynamicMesh.GetVertex(Tri.B)),
+						DynamicMesh.AppendVertex(DynamicMesh.GetVertex(Tri.C)));
+					if (DynamicMesh.AppendTriangle(Copy) >= 0)
+						++NumNonManifold;
+					else
+						++NumDropped;
+				}
+				else if (TriangleID < 0)
+				{
+					// 중복 또는 퇴화 삼각형
+					++NumDropped;
+				}
+			}
+
+			// 절단면과 표면의 경계가 각지게 보이도록 각도 기준으로 노멀 분리
+			DynamicMesh.EnableAttributes();
+			UE::Geometry::FDynamicMeshNormalOverlay* NormalOverlay = DynamicMesh.Attributes()->PrimaryNormals();
+			UE::Geometry::FMeshNormals::InitializeOverlayTopologyFromOpeningAngle(&DynamicMesh, NormalOverlay, FragmentNormalAngle);
+			UE::Geometry::FMeshNormals Normals(&DynamicMesh);
+			Normals.RecomputeOverlayNormals(NormalOverlay);
+			Normals.CopyToOverlay(NormalOverlay);
+
+			Fragment.MassProperties = MassProperties.FindRef(MeshKey);
+			Fragment.Collision = ComputeCollision(VertexArray, Fragment.MassProperties);
+		});
+
+	if (NumNonManifold > 0 || NumDropped > 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Fragment build: %d non-manifold triangles split off, %d duplicate/invalid triangles dropped"), NumNonManifold.load(), NumDropped.load());
+	}
+
+	for (const FFragment& Fragment : Fragments)
+	{
+		UE_LOG(LogTemp, VeryVerbose, TEXT("Vertex %d, Triangle %d"), Fragment.Mesh.VertexCount(), Fragment.Mesh.TriangleCount());
+	}
+
+	return Fragments;
+}
+
+// 사면체에서 메쉬를 분리하고 새 메쉬 반환
+TMap<uint32, UProceduralMeshComponent*> SplitMesh::Split()
+{
+	TArray<uint32> SeedArray;
+	TMap<uint32, TArray<int32>> Triangles;
+	TMap<uint32, TArray<FVector>> Vertices;
+
+	BuildRegions(false, SeedArray, Triangles, Vertices);
+	return BuildRegionMeshes(SeedArray, Triangles, Vertices);
+}
+
+// 사면체를 자르지 않고 통째로 한 영역에 배정 (새 정점 없음)
+// 네 정점 중 가장 많은 라벨, 동률이면 Source까지의 거리가 가장 가까운 정점의 라벨
+int32 SplitMesh::AssignTet(const int32& TetIndex, FSplitTetOutput& Out) const
+{
+	const FIntVector4& tetra = (*Tets)[TetIndex];
+
+	int32 Best = 0;
+	int32 BestCount = 0;
+	for (int i = 0; i < 4; ++i)
+	{
+		int32 Count = 0;
+		for (int j = 0; j < 4; ++j)
+		{
+			Count += Labels[tetra[j]] == Labels[tetra[i]];
+		}
+		if (Count > BestCount || (Count == BestCount && Dists[tetra[i]] < Dists[tetra[Best]]))
+		{
+			Best = i;
+			BestCount = Count;
+		}
+	}
+
+	Out.Num = 1;
+	Out.Tets[0] = tetra;
+	Out.Regions[0] = Labels[tetra[Best]];
+	return Out.Num;
+}
+
+// 사면체 경계면을 그대로 조각 경계로 사용하는 빠른 분리
+TMap<uint32, UProceduralMeshComponent*> SplitMesh::SplitByTets()
+{
+	TArray<uint32> SeedArray;
+	TMap<uint32, TArray<int32>> Triangles;
+	TMap<uint32, TArray<FVector>> Vertices;
+
+	BuildRegions(true, SeedArray, Triangles, Vertices);
+	return BuildRegionMeshes(SeedArray, Triangles, Vertices);
+}
+
+// 컴포넌트 없이 이동 가능한 메쉬 버퍼로 조각 생성
+TArray<FFragment> SplitMesh::SplitFragments(const bool bTetGranular)
+{
+	TArray<uint32> SeedArray;
+	TMap<uint32, TArray<int32>> Triangles;
+	TMap<uint32, TArray<FVector>> Vertices;
+
+	BuildRegions(bTetGranular, SeedArray, Triangles, Vertices);
+	TArray<FFragment> Fragments = BuildFragments(SeedArray, Triangles, Vertices);
+	if (IsCancelled())
+		Fragments.Reset();
+	return Fragments;
+}
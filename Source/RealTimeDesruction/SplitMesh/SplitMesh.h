@@ -3,9 +3,63 @@
 #include "CoreMinimal.h"
 #include "../DistanceCalculate/DistanceCalculate.h"
 #include "ProceduralMeshComponent.h"
-#include <shared_mutex>
+#include "DynamicMesh/DynamicMesh3.h"
 #include "../FEM/FEMCalculateComponent.h"
 
+// SplitTetra 결과를 담는 고정 크기 버퍼 (한 사면체는 최대 8개로 분할됨)
+struct FSplitTetOutput
+{
+	static constexpr int32 MaxTets = 8;
+
+	FIntVector4 Tets[MaxTets];
+	uint32 Regions[MaxTets];
+	int32 Num = 0;
+};
+
+// 사면체로부터 계산한 조각의 질량 특성 (단위 밀도, cm 단위)
+struct FFragmentMassProperties
+{
+	double Volume = 0.0;							// cm³
+	FVector CenterOfMass = FVector::ZeroVector;		// 로컬 좌표
+	FVector PrincipalInertia = FVector::ZeroVector;	// 주축 관성 모멘트 (cm⁵, 밀도를 곱하면 관성 텐서)
+	FQuat PrincipalRotation = FQuat::Identity;		// 로컬 좌표계 대비 주축 회전
+};
+
+// 조각 크기별 충돌 표현
+enum class EFragmentCollisionTier : uint8
+{
+	Sphere,			// 가장 작은 조각: 구
+	Box,			// 작은 조각: 주축 방향 상자
+	SimplifiedHull,	// 중간 조각: 정점 수를 줄인 볼록 껍질
+	Hull			// 큰 조각: MaxHullVertices 볼록 껍질
+};
+
+// 조각의 충돌 형상 (로컬 좌표)
+struct FFragmentCollision
+{
+	EFragmentCollisionTier Tier = EFragmentCollisionTier::Hull;
+	TArray<FVector> Hull;		// 볼록 껍질 정점. Sphere/Box 티어는 볼록 메쉬만 받는 경로를 위해 상자 꼭짓점 8개
+	FVector Center = FVector::ZeroVector;
+	FQuat Rotation = FQuat::Identity;
+	FVector Extent = FVector::ZeroVector;	// Box 반 크기
+	float Radius = 0.f;						// Sphere 반지름
+};
+
+// 영역 하나의 조각 형상. 복사 없이 액터까지 이동만 하도록 복사를 막음
+struct FFragment
+{
+	uint32 Region = 0;
+	UE::Geometry::FDynamicMesh3 Mesh;
+	FFragmentCollision Collision;
+	FFragmentMassProperties MassProperties;
+
+	FFragment() = default;
+	FFragment(FFragment&&) = default;
+	FFragment& operator=(FFragment&&) = default;
+	FFragment(const FFragment&) = delete;
+	FFragment& operator=(const FFragment&) = delete;
+};
+
 // Not sure it is working...
 class REALTIMEDESRUCTION_API SplitMesh
 {
@@ -13,11 +67,51 @@ public:
 	SplitMesh(const UStaticMesh* Mesh, const UFEMCalculateComponent* FEMComponent, const TMap<uint32, DistOutEntry>* Distance);
 	~SplitMesh() {};
 	FVector3f CalculateSplitPoint(const int32& p1, const int32& p2);
-	TMap<uint32, TArray<FIntVector4>> SplitTetra(const FIntVector4& tetra);
+	int32 SplitTetra(const int32& TetIndex, FSplitTetOutput& Out) const;
 	TMap<uint32, UProceduralMeshComponent*> Split();
 
+	// 사면체를 자르지 않고 사면체 단위로 영역에 배정하는 빠른 분리
+	int32 AssignTet(const int32& TetIndex, FSplitTetOutput& Out) const;
+	TMap<uint32, UProceduralMeshComponent*> SplitByTets();
+
+	// 컴포넌트 대신 FDynamicMesh3 조각으로 출력 (노멀 포함)
+	TArray<FFragment> SplitFragments(const bool bTetGranular = false);
+
+	// Split/SplitByTets로 만든 영역별 충돌 형상
+	const TMap<uint32, FFragmentCollision>& GetCollisions() const { return Collisions; }
+
+	// 영역별 질량 특성
+	const TMap<uint32, FFragmentMassProperties>& GetMassProperties() const { return MassProperties; }
+
+	// 충돌 볼록 껍질의 최대 정점 수
+	int32 MaxHullVertices = 32;
+
+	// 영역 부피(로컬 cm³)가 각 값 미만이면 해당 충돌 티어 사용. 0이면 그 티어는 사용 안 함
+	double SphereCollisionVolume = 0.0;
+	double BoxCollisionVolume = 0.0;
+	double SimplifiedHullVolume = 0.0;
+	int32 SimplifiedHullVertices = 12;
+
+	// 설정되면 단계 사이와 영역별 작업 시작 시 확인해 취소되었으면 빈 결과 반환
+	const std::atomic<bool>* CancelFlag = nullptr;
+	bool IsCancelled() const { return CancelFlag && CancelFlag->load(std::memory_order_relaxed); }
+
 private:
-	void GenerateCombinations(const TArray<int32>& InputArray, TArray<int32>& CurrentCombination, int32 StartIndex, int32 CombinationSize, TArray<TArray<int32>>& Result);
+	void CollectSurfaceTriangles(TMap<uint32, TArray<int32>>& Triangles) const;
+	void AllocateSplitVertices();
+	void GatherRegionTets(TFunctionRef<void(int32, FSplitTetOutput&)> SplitOne, TArray<uint32>& SeedArray, TMap<uint32, TArray<FIntVector4>>& TetMeshes) const;
+	void ExtractRegionSurfaces(const TArray<uint32>& SeedArray, const TMap<uint32, TArray<FIntVector4>>& TetMeshes, TMap<uint32, TArray<int32>>& Triangles, TMap<uint32, TArray<FVector>>& Vertices) const;
+	void BuildRegions(const bool bTetGranular, TArray<uint32>& SeedArray, TMap<uint32, TArray<int32>>& Triangles, TMap<uint32, TArray<FVector>>& Vertices);
+	TMap<uint32, UProceduralMeshComponent*> BuildRegionMeshes(const TArray<uint32>& SeedArray, const TMap<uint32, TArray<int32>>& Triangles, const TMap<uint32, TArray<FVector>>& Vertices);
+	TArray<FFragment> BuildFragments(const TArray<uint32>& SeedArray, const TMap<uint32, TArray<int32>>& Triangles, const TMap<uint32, TArray<FVector>>& Vertices) const;
+
+	FVector GetVertexPosition(const int32 GlobalIndex) const;
+	FFragmentMassProperties ComputeMassProperties(const TArray<FIntVector4>& RegionTets) const;
+	FFragmentCollision ComputeCollision(const TArray<FVector>& Points, const FFragmentMassProperties& Properties) const;
+
+	// 이 각도(도)보다 크게 꺾인 모서리에서 노멀 분리
+	static constexpr double FragmentNormalAngle = 60.0;
+
 
 	const UStaticMesh* Mesh;
 	const UFEMCalculateComponent* FEMComponent;
@@ -27,5 +121,9 @@ private:
 	const TArray<FIntVector4>* Tets;
 	uint32 NumVertices;
 	TArray<FVector3f> VerticesToAdd;
-	TSet<uint32> Seed;
+	TArray<uint32> Labels;	// 사면체 정점별 가장 가까운 Source
+	TArray<double> Dists;	// 사면체 정점별 Source까지의 거리
+	TMap<uint32, FFragmentCollision> Collisions;
+	TMap<uint32, FFragmentMassProperties> MassProperties;
+	TArray<int32> EdgeSplitVertex;	// FEMComponent->TetEdges별 분리 정점 인덱스, 절단되지 않으면 INDEX_NONE
 };
\ No newline at end of file
@@ -81,6 +81,18 @@ TArray<uint32> ATestActor_CVT::getRandomVoronoiSites(const TArray<FVector>& Vert
 
 void ATestActor_CVT::ExecuteCVT()
 {
+    CVT Accelerated = CVT_inst;
+
     CVT_inst.Lloyd_Algo();
+
+    if (bCompareAcceleratedCVT)
+    {
+        Accelerated.Anderson_Lloyd_Algo();
+        UE_LOG(LogTemp, Warning, TEXT("[CVT] Lloyd: %d iterations, %.3f ms | Anderson: %d iterations, %.3f ms | Speedup: %.2fx"),
+            CVT_inst.LastStats.Iterations, CVT_inst.LastStats.TimeMs,
+            Accelerated.LastStats.Iterations, Accelerated.LastStats.TimeMs,
+            Accelerated.LastStats.TimeMs > 0.0 ? CVT_inst.LastStats.TimeMs / Accelerated.LastStats.TimeMs : 0.0);
+    }
+
     VisualizeVertices();
 }
\ No newline at end of file
@@ -39,6 +39,10 @@ private:
 	UPROPERTY(EditAnywhere)
 	uint32 NumOfVoronoiSites;
 
+	// 동일한 초기 사이트로 앤더슨 가속 CVT를 함께 실행하여 일반 로이드와 비교
+	UPROPERTY(EditAnywhere)
+	bool bCompareAcceleratedCVT = true;
+
 	void ExecuteCVT();
 
 	// Ÿ�̸� �ڵ�
@@ -0,0 +1,33 @@
+#include "DestructMeshAsyncAction.h"
+
+UDestructMeshAsyncAction* UDestructMeshAsyncAction::DestructMeshAsync(UVoroTestComponent* Component, const float Energy, const ESplitMode Mode)
+{
+	UDestructMeshAsyncAction* Action = NewObject<UDestructMeshAsyncAction>();
+	Action->Component = Component;
+	Action->Energy = Energy;
+	Action->Mode = Mode;
+	Action->RegisterWithGameInstance(Component);
+	return Action;
+}
+
+void UDestructMeshAsyncAction::Activate()
+{
+	UVoroTestComponent* Target = Component.Get();
+	if (!Target)
+	{
+		HandleFinished(false);
+		return;
+	}
+
+	Target->DestructMeshAsync(Energy, Mode, FOnDestructionFinished::CreateUObject(this, &UDestructMeshAsyncAction::HandleFinished));
+}
+
+void UDestructMeshAsyncAction::HandleFinished(bool bSucceeded)
+{
+	if (bSucceeded)
+		OnCompleted.Broadcast();
+	else
+		OnCancelled.Broadcast();
+
+	SetReadyToDestroy();
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintAsyncActionBase.h"
+#include "VoroTestComponent.h"
+#include "DestructMeshAsyncAction.generated.h"
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FDestructMeshAsyncPin);
+
+/**
+ * UVoroTestComponent::DestructMeshAsync의 블루프린트 노드
+ * 분리 계산이 워커 스레드에서 끝나고 조각이 생성되면 OnCompleted, 취소되면 OnCancelled 실행
+ */
+UCLASS()
+class REALTIMEDESRUCTION_API UDestructMeshAsyncAction : public UBlueprintAsyncActionBase
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(BlueprintAssignable)
+	FDestructMeshAsyncPin OnCompleted;
+
+	UPROPERTY(BlueprintAssignable)
+	FDestructMeshAsyncPin OnCancelled;
+
+	UFUNCTION(BlueprintCallable, Category = "Destruction", meta = (BlueprintInternalUseOnly = "true", DisplayName = "Destruct Mesh Async"))
+	static UDestructMeshAsyncAction* DestructMeshAsync(UVoroTestComponent* Component, const float Energy, const ESplitMode Mode);
+
+	virtual void Activate() override;
+
+private:
+	void HandleFinished(bool bSucceeded);
+
+	TWeakObjectPtr<UVoroTestComponent> Component;
+	float Energy = 0.f;
+	ESplitMode Mode = ESplitMode::Exact;
+};
@@ -0,0 +1,69 @@
+#include "VoroTestComponent.h"
+#include "HAL/IConsoleManager.h"
+#include "Async/ParallelFor.h"
+
+#if !UE_BUILD_SHIPPING
+
+// 월드의 파괴 가능 액터 N개를 동시에 파괴 계산하고(조각 액터 생성 없음) 순차 실행 대비 처리량 비교
+// 사용법: Destruction.StressBenchmark [N] [Energy]
+static void RunDestructionStressBenchmark(const TArray<FString>& Args, UWorld* World)
+{
+	const int32 NumRequested = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 8;
+	const float Energy = Args.Num() > 1 ? FCString::Atof(*Args[1]) : 1000.f;
+
+	TArray<UVoroTestComponent*> Components;
+	for (TObjectIterator<UVoroTestComponent> It; It && Components.Num() < NumRequested; ++It)
+	{
+		if (It->GetWorld() == World && It->HasBegunPlay() && !It->IsDestructionInProgress())
+			Components.Add(*It);
+	}
+
+	if (Components.Num() == 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[StressBenchmark] No destructible components in world"));
+		return;
+	}
+
+	// 벤치마크 불가능한 컴포넌트 제외 (한 번 실행해 캐시와 그래프도 워밍업)
+	Components.RemoveAll([Energy](UVoroTestComponent* Component) { return Component->RunDestructionStages(Energy, Component->SplitMode) == INDEX_NONE; });
+	if (Components.Num() == 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[StressBenchmark] No component can run off the game thread (needs dynamic mesh output and an impact)"));
+		return;
+	}
+
+	UE_LOG(LogTemp, Warning, TEXT("[StressBenchmark] Actors: %d, Energy: %.1f, Workers: %d"), Components.Num(), Energy, FTaskGraphInterface::Get().GetNumWorkerThreads());
+
+	std::atomic<int32> NumFragments(0);
+	auto RunBatch = [&](const int32 Count, const bool bConcurrent) -> double
+	{
+		NumFragments = 0;
+		const double StartTime = FPlatformTime::Seconds();
+		ParallelFor(Count, [&](int32 Index)
+			{
+				UVoroTestComponent* Component = Components[Index];
+				NumFragments += FMath::Max(Component->RunDestructionStages(Energy, Component->SplitMode), 0);
+			}, bConcurrent ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+		return (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	};
+
+	for (int32 Count = 1; ; Count = FMath::Min(Count * 2, Components.Num()))
+	{
+		const double SequentialMs = RunBatch(Count, false);
+		const double ConcurrentMs = RunBatch(Count, true);
+
+		UE_LOG(LogTemp, Warning, TEXT("[StressBenchmark] N=%3d | Sequential: %8.2f ms | Concurrent: %8.2f ms | Throughput: %6.2f actors/s | Speedup: %.2fx | Fragments: %d"),
+			Count, SequentialMs, ConcurrentMs, Count * 1000.0 / FMath::Max(ConcurrentMs, UE_DOUBLE_SMALL_NUMBER),
+			SequentialMs / FMath::Max(ConcurrentMs, UE_DOUBLE_SMALL_NUMBER), NumFragments.load());
+
+		if (Count == Components.Num())
+			break;
+	}
+}
+
+static FAutoConsoleCommandWithWorldAndArgs GDestructionStressBenchmarkCommand(
+	TEXT("Destruction.StressBenchmark"),
+	TEXT("Break N destructible actors concurrently without spawning fragments and log throughput scaling. Usage: Destruction.StressBenchmark [N] [Energy]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&RunDestructionStressBenchmark));
+
+#endif
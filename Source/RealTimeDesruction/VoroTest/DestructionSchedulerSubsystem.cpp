@@ -0,0 +1,332 @@
+#include "DestructionSchedulerSubsystem.h"
+#include "../SplitActor/FragmentBudgetSubsystem.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+
+DECLARE_CYCLE_STAT(TEXT("Destruction Scheduler"), STAT_DestructionScheduler, STATGROUP_Destruction);
+DECLARE_CYCLE_STAT(TEXT("Radial Impact"), STAT_RadialImpact, STATGROUP_Destruction);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pending Destructions"), STAT_PendingDestructions, STATGROUP_Destruction);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Destruction Quality Level"), STAT_DestructionQualityLevel, STATGROUP_Destruction);
+
+bool UDestructionSchedulerSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UDestructionSchedulerSubsystem::Deinitialize()
+{
+	// 진행 중인 워커 단계는 취소하고 끝날 때까지 대기 (영역/분리 루프가 취소 플래그를 확인)
+	for (const TUniquePtr<FRequest>& Request : Requests)
+	{
+		if (Request->Job.IsValid())
+		{
+			Request->Job->bCancelled = true;
+			Request->Job->WorkerStages.Wait();
+		}
+		ReleaseRequest(*Request);
+	}
+	Requests.Empty();
+	Super::Deinitialize();
+}
+
+TStatId UDestructionSchedulerSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UDestructionSchedulerSubsystem, STATGROUP_Tickables);
+}
+
+bool UDestructionSchedulerSubsystem::Submit(UVoroTestComponent* Component, const float Energy, const ESplitMode Mode)
+{
+	UStaticMeshComponent* MeshComponent = IsValid(Component) ? Component->GetOwner()->FindComponentByClass<UStaticMeshComponent>() : nullptr;
+	const UStaticMesh* Mesh = MeshComponent ? MeshComponent->GetStaticMesh() : nullptr;
+	if (!Mesh || !Component->FEMComponent)
+		return false;
+
+	for (const TUniquePtr<FRequest>& Request : Requests)
+	{
+		if (Request->Component.Get() == Component)
+			return false;
+	}
+
+	TUniquePtr<FRequest> Request = MakeUnique<FRequest>();
+	Request->Component = Component;
+	Request->Energy = Energy;
+	Request->Mode = Mode;
+	Request->Mesh = Mesh;
+	// 요청이 끝날 때까지 FEM은 새 충격을 거부하므로 스폰 단계까지 같은 충격 정보가 유지됨
+	Request->Impact = Component->FEMComponent->GetCurrentImpact();
+	Component->FEMComponent->bDestructionLocked = true;
+	Request->NumVertices = Component->FEMComponent->TetMeshVertices.Num();
+	Request->SubmitTime = GetWorld()->GetTimeSeconds();
+	Requests.Add(MoveTemp(Request));
+	return true;
+}
+
+// 화면에서 크게 보일수록(경계 반지름 / 카메라 거리) 먼저 처리. 오래 기다린 요청은 점점 올려 기아 방지
+void UDestructionSchedulerSubsystem::UpdatePriorities()
+{
+	FVector ViewLocation = FVector::ZeroVector;
+	bool bHasView = false;
+	if (APlayerController* PC = GetWorld()->GetFirstPlayerController())
+	{
+		FRotator ViewRotation;
+		PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+		bHasView = true;
+	}
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	for (const TUniquePtr<FRequest>& Request : Requests)
+	{
+		const AActor* Owner = Request->Component.IsValid() ? Request->Component->GetOwner() : nullptr;
+		if (!Owner)
+		{
+			Request->Priority = TNumericLimits<float>::Max();	// 바로 정리되도록
+			continue;
+		}
+
+		FVector Origin;
+		FVector Extent;
+		Owner->GetActorBounds(true, Origin, Extent);
+		const float Distance = bHasView ? FMath::Max((float)FVector::Dist(ViewLocation, Origin), 1.f) : 1.f;
+		const float ScreenSize = (float)Extent.Size() / Distance;
+		Request->Priority = ScreenSize * (1.f + (float)(Now - Request->SubmitTime));
+	}
+
+	Requests.Sort([](const TUniquePtr<FRequest>& A, const TUniquePtr<FRequest>& B) { return A->Priority > B->Priority; });
+}
+
+double UDestructionSchedulerSubsystem::EstimateStageMs(const FRequest& Request, const EStage Stage) const
+{
+	return StageMsPerVertex[(int32)Stage] * Request.NumVertices;
+}
+
+void UDestructionSchedulerSubsystem::UpdateQualityLevel()
+{
+	if (!bAllowQualityDegradation)
+	{
+		QualityLevel = 0;
+		return;
+	}
+
+	double BacklogMs = 0.0;
+	for (const TUniquePtr<FRequest>& Request : Requests)
+	{
+		for (int32 Stage = (int32)Request->Stage; Stage < (int32)EStage::Num; ++Stage)
+			BacklogMs += EstimateStageMs(*Request, (EStage)Stage);
+	}
+
+	const double Allowed = (double)FrameBudgetMs * TargetLatencyFrames;
+	QualityLevel = FMath::Clamp(FMath::FloorToInt32(BacklogMs / Allowed), 0, 3);
+}
+
+void UDestructionSchedulerSubsystem::ReleaseRequest(FRequest& Request)
+{
+	UVoroTestComponent* Component = Request.Component.Get();
+	if (!Component)
+		return;
+
+	Component->bDestructionScheduled = false;
+	if (Component->FEMComponent)
+		Component->FEMComponent->bDestructionLocked = false;
+	if (Request.Job.IsValid() && Component->ActiveJob == Request.Job)
+		Component->ActiveJob.Reset();
+}
+
+void UDestructionSchedulerSubsystem::DispatchRequest(FRequest& Request)
+{
+	// 품질은 요청이 시작될 때 한 번만 정함
+	Request.Quality.bAllowCVT = QualityLevel < 1;
+	Request.Quality.SeedScale = QualityLevel < 2 ? 1.f : 0.5f;
+	Request.Quality.bForceTetGranular = QualityLevel >= 3;
+
+	Request.Job = Request.Component->LaunchWorkerStages(Request.Energy, Request.Impact, Request.Mode, Request.Quality, Request.Mesh);
+}
+
+void UDestructionSchedulerSubsystem::SpawnRequest(FRequest& Request)
+{
+	UVoroTestComponent* Component = Request.Component.Get();
+	Component->bDestructionScheduled = false;
+	Component->FinishJob(*Request.Job);
+}
+
+void UDestructionSchedulerSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_DestructionScheduler);
+
+	if (Requests.Num() > 0)
+	{
+		UpdatePriorities();
+		UpdateQualityLevel();
+
+		const double StartTime = FPlatformTime::Seconds();
+		auto ElapsedMs = [StartTime]() { return (FPlatformTime::Seconds() - StartTime) * 1000.0; };
+
+		const int32 MaxInFlight = FMath::Max(FTaskGraphInterface::Get().GetNumWorkerThreads(), 1);
+		int32 NumInFlight = 0;
+		for (const TUniquePtr<FRequest>& Request : Requests)
+		{
+			if (Request->Job.IsValid() && Request->Stage != EStage::Spawn)
+				++NumInFlight;
+		}
+
+		// 우선순위 순으로 워커 단계를 시작하거나 완료를 확인하고, 끝난 요청은 예산 안에서 조각 생성
+		// 생성은 예상 시간이 남은 예산을 넘으면 다음 프레임으로 미루되 프레임마다 최소 한 건은 실행
+		bool bSpawned = false;
+		for (int32 i = 0; i < Requests.Num(); )
+		{
+			FRequest& Request = *Requests[i];
+			UVoroTestComponent* Component = Request.Component.Get();
+
+			// EndPlay에서 진행 중인 작업은 이미 취소되고 정리됨
+			if (!IsValid(Component) || !Component->FEMComponent || (Request.Job.IsValid() && Request.Job->bCancelled))
+			{
+				if (Request.Job.IsValid() && Request.Stage != EStage::Spawn)
+					--NumInFlight;
+				ReleaseRequest(Request);
+				Requests.RemoveAt(i, 1, EAllowShrinking::No);
+				continue;
+			}
+
+			if (!Request.Job.IsValid())
+			{
+				if (NumInFlight < MaxInFlight)
+				{
+					DispatchRequest(Request);
+					++NumInFlight;
+				}
+			}
+			else if (Request.Stage != EStage::Spawn && Request.Job->WorkerStages.IsCompleted())
+			{
+				// 워커 실측 시간으로 단계별 예상 시간 갱신 (품질 조절용)
+				if (Request.NumVertices > 0)
+				{
+					StageMsPerVertex[(int32)EStage::Regions] = FMath::Lerp(StageMsPerVertex[(int32)EStage::Regions], Request.Job->RegionsMs / Request.NumVertices, 0.2);
+					if (Request.Job->bSplitOnWorker)
+						StageMsPerVertex[(int32)EStage::Split] = FMath::Lerp(StageMsPerVertex[(int32)EStage::Split], Request.Job->SplitMs / Request.NumVertices, 0.2);
+				}
+				Request.Stage = EStage::Spawn;
+				--NumInFlight;
+			}
+
+			if (Request.Stage == EStage::Spawn && (!bSpawned || ElapsedMs() + EstimateStageMs(Request, EStage::Spawn) <= FrameBudgetMs))
+			{
+				const double SpawnStart = ElapsedMs();
+				SpawnRequest(Request);
+				bSpawned = true;
+
+				if (Request.NumVertices > 0)
+					StageMsPerVertex[(int32)EStage::Spawn] = FMath::Lerp(StageMsPerVertex[(int32)EStage::Spawn], (ElapsedMs() - SpawnStart) / Request.NumVertices, 0.2);
+
+				Requests.RemoveAt(i, 1, EAllowShrinking::No);
+				continue;
+			}
+
+			++i;
+		}
+	}
+
+	SET_DWORD_STAT(STAT_PendingDestructions, Requests.Num());
+	SET_DWORD_STAT(STAT_DestructionQualityLevel, QualityLevel);
+}
+
+int32 UDestructionSchedulerSubsystem::ApplyRadialImpact(const FVector& Origin, const float Radius, const float Impulse)
+{
+	SCOPE_CYCLE_COUNTER(STAT_RadialImpact);
+
+	// 액터 하나의 입력과 단계별 결과. 배치 전체를 한 번에 할당
+	struct FBatchEntry
+	{
+		UVoroTestComponent* Component = nullptr;
+		const UStaticMesh* Mesh = nullptr;
+		FVector LocalHitPoint = FVector::ZeroVector;
+		FVector LocalVelocity = FVector::ZeroVector;
+		FVector Scale = FVector::OneVector;
+		float Energy = 0.f;
+		bool bBreak = false;
+		TMap<uint32, DistOutEntry> DistanceMap;
+		TArray<UVoroTestComponent::FPendingFragment> Fragments;
+	};
+
+	UWorld* World = GetWorld();
+	if (!World || Radius <= 0.f)
+		return 0;
+
+	TArray<FOverlapResult> Overlaps;
+	World->OverlapMultiByObjectType(Overlaps, Origin, FQuat::Identity, FCollisionObjectQueryParams(FCollisionObjectQueryParams::AllObjects), FCollisionShape::MakeSphere(Radius));
+
+	TSet<AActor*> VisitedActors;
+	TArray<FBatchEntry> Batch;
+	for (const FOverlapResult& Overlap : Overlaps)
+	{
+		AActor* Actor = Overlap.GetActor();
+		if (!Actor || VisitedActors.Contains(Actor))
+			continue;
+		VisitedActors.Add(Actor);
+
+		UVoroTestComponent* Component = Actor->FindComponentByClass<UVoroTestComponent>();
+		UStaticMeshComponent* MeshComponent = Actor->FindComponentByClass<UStaticMeshComponent>();
+		if (!Component || !Component->FEMComponent || Component->IsDestructionInProgress() || !MeshComponent || !MeshComponent->GetStaticMesh())
+			continue;
+
+		// 폭발 중심에서 가장 가까운 표면 지점을 충돌 지점으로 사용. 충돌체가 없으면 경계 중심
+		FVector HitPoint;
+		float Distance = MeshComponent->GetClosestPointOnCollision(Origin, HitPoint);
+		if (Distance < 0.f)
+		{
+			HitPoint = MeshComponent->Bounds.Origin;
+			Distance = (float)FVector::Dist(Origin, HitPoint);
+		}
+
+		FVector Direction = (HitPoint - Origin).GetSafeNormal();
+		if (Direction.IsNearlyZero())
+			Direction = (MeshComponent->Bounds.Origin - Origin).GetSafeNormal(UE_SMALL_NUMBER, FVector::UpVector);
+
+		// 충격량은 거리에 따라 선형 감쇠. 단위 질량 물체가 멈추는 충돌로 취급
+		const float Falloff = 1.f - FMath::Clamp(Distance / Radius, 0.f, 1.f);
+		const FTransform& OwnerTransform = Actor->GetActorTransform();
+
+		FBatchEntry& Entry = Batch.AddDefaulted_GetRef();
+		Entry.Component = Component;
+		Entry.Mesh = MeshComponent->GetStaticMesh();
+		Entry.LocalHitPoint = OwnerTransform.InverseTransformPosition(HitPoint);
+		Entry.LocalVelocity = OwnerTransform.InverseTransformVectorNoScale(Direction) * Impulse * Falloff;
+		Entry.Scale = OwnerTransform.GetScale3D();
+	}
+
+	if (Batch.Num() == 0)
+		return 0;
+
+	// 에너지, 영역, 분리를 액터별로 한 작업에 묶어 같은 워커 풀에서 병렬 처리 (액터 간 공유 상태 없음)
+	ParallelFor(Batch.Num(), [&Batch](int32 Index)
+		{
+			FBatchEntry& Entry = Batch[Index];
+			UVoroTestComponent* Component = Entry.Component;
+
+			Entry.Energy = Component->FEMComponent->CalculateEnergyAtTatUsingFEM(Entry.LocalVelocity, FVector::ZeroVector, 1.f, Entry.LocalHitPoint);
+			Entry.bBreak = Entry.Energy >= Component->DestructionThreshold;
+			if (!Entry.bBreak)
+				return;
+
+			Component->ComputeRegions(Entry.Energy, Component->FEMComponent->GetCurrentImpact(), Entry.Scale, Entry.DistanceMap);
+			if (Component->bUseDynamicMeshOutput)
+				Component->BuildPendingFragments(&Entry.DistanceMap, Component->SplitMode, Entry.Mesh, Entry.Scale, Entry.Fragments);
+		});
+
+	int32 NumBroken = 0;
+	for (FBatchEntry& Entry : Batch)
+	{
+		if (!Entry.bBreak)
+			continue;
+
+		// 프로시저럴 경로는 NewObject가 필요하므로 분리를 게임 스레드에서 수행
+		if (!Entry.Component->bUseDynamicMeshOutput)
+			Entry.Component->BuildPendingFragments(&Entry.DistanceMap, Entry.Component->SplitMode, Entry.Mesh, Entry.Scale, Entry.Fragments);
+
+		Entry.Component->SpawnPendingFragments(MoveTemp(Entry.Fragments));
+		++NumBroken;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("Radial impact: %d destructibles in range, %d broken"), Batch.Num(), NumBroken);
+	return NumBroken;
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "VoroTestComponent.h"
+#include "DestructionSchedulerSubsystem.generated.h"
+
+/**
+ * 월드 단위 파괴 스케줄러
+ *
+ * UVoroTestComponent가 제출한 파괴 요청을 화면 크기와 카메라 거리로 우선순위를 매겨 처리
+ * 영역 계산과 분리는 우선순위 순으로 워커 태스크에 넘기고(동시 실행 수는 워커 스레드 수까지),
+ * 게임 스레드에서는 완료 확인과 조각 생성만 프레임당 FrameBudgetMs 안에서 수행하고 나머지는 다음 프레임으로 미룸
+ * 대기 중인 작업이 예산을 크게 넘기면 CVT 생략, 시드 수 감소, 사면체 단위 분리 순으로 품질을 낮춤
+ */
+UCLASS(config = Game)
+class REALTIMEDESRUCTION_API UDestructionSchedulerSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// 요청을 큐에 넣음. 충격 정보는 이 시점의 값을 복사해 사용. 이미 대기 중인 컴포넌트면 false
+	bool Submit(UVoroTestComponent* Component, const float Energy, const ESplitMode Mode);
+
+	/**
+	 * 폭발 등 범위 충격. Radius 안의 파괴 가능 액터를 모두 찾아 한 번의 병렬 패스로 파괴
+	 * 액터별 충돌 지점(중심에서 가장 가까운 표면)과 거리 감쇠된 충격량으로 FEM 에너지를 구하고,
+	 * DestructionThreshold를 넘는 액터는 영역 계산과 분리까지 같은 ParallelFor 안에서 수행
+	 * 조각 생성만 게임 스레드에서 처리. 파괴된 액터 수 반환
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Destruction")
+	int32 ApplyRadialImpact(const FVector& Origin, const float Radius, const float Impulse);
+
+	UFUNCTION(BlueprintPure, Category = "Destruction")
+	int32 GetNumPendingRequests() const { return Requests.Num(); }
+
+	// 0: 최고 품질, 1: CVT 생략, 2: 시드 절반, 3: 사면체 단위 분리
+	UFUNCTION(BlueprintPure, Category = "Destruction")
+	int32 GetQualityLevel() const { return QualityLevel; }
+
+	// 프레임당 조각 생성에 쓸 게임 스레드 시간(ms). 최소 한 건은 생성해 진행을 보장
+	UPROPERTY(config, EditAnywhere, BlueprintReadWrite, Category = "Destruction", meta = (ClampMin = "0.1"))
+	float FrameBudgetMs = 4.f;
+
+	// 대기 작업 예상 시간이 FrameBudgetMs * 이 값을 넘을 때마다 품질을 한 단계씩 낮춤
+	UPROPERTY(config, EditAnywhere, BlueprintReadWrite, Category = "Destruction", meta = (ClampMin = "1"))
+	int32 TargetLatencyFrames = 8;
+
+	UPROPERTY(config, EditAnywhere, BlueprintReadWrite, Category = "Destruction")
+	bool bAllowQualityDegradation = true;
+
+private:
+	enum class EStage : uint8
+	{
+		Regions,
+		Split,
+		Spawn,
+		Num
+	};
+
+	struct FRequest
+	{
+		TWeakObjectPtr<UVoroTestComponent> Component;
+		float Energy = 0.f;
+		ESplitMode Mode = ESplitMode::Exact;
+		EStage Stage = EStage::Regions;
+		FDestructionQuality Quality;
+		FFEMImpact Impact;
+		const UStaticMesh* Mesh = nullptr;
+		TSharedPtr<UVoroTestComponent::FDestructionJob> Job;	// 워커 단계를 시작하면 설정
+		int32 NumVertices = 0;
+		double SubmitTime = 0.0;
+		float Priority = 0.f;
+	};
+
+	void UpdatePriorities();
+	void UpdateQualityLevel();
+	double EstimateStageMs(const FRequest& Request, const EStage Stage) const;
+	// 영역 계산과 분리를 워커 태스크로 시작
+	void DispatchRequest(FRequest& Request);
+	// 게임 스레드 단계: 조각 생성
+	void SpawnRequest(FRequest& Request);
+	// 요청이 끝나거나 버려질 때 컴포넌트의 예약 상태와 FEM 충격 잠금 해제
+	void ReleaseRequest(FRequest& Request);
+
+	TArray<TUniquePtr<FRequest>> Requests;
+
+	// 단계별 사면체 정점 1개당 예상 시간(ms). 실측값의 지수 이동 평균
+	double StageMsPerVertex[(int32)EStage::Num] = { 0.002, 0.004, 0.001 };
+	int32 QualityLevel = 0;
+};
@@ -2,6 +2,7 @@
 
 
 #include "VoroTestComponent.h"
+#include "DestructionSchedulerSubsystem.h"
 
 // For Voronoi Cells
 TMap<int32, FColor> ColorMap = {
@@ -21,6 +22,8 @@ UVoroTestComponent::UVoroTestComponent()
 	// Set this component to be initialized when the game starts, and to be ticked every frame.  You can turn these features
 	// off to improve performance if you don't need them.
 	PrimaryComponentTick.bCanEverTick = true;
+	// 같은 프레임 물리 충돌로 쌓인 충격을 그 프레임 안에 처리
+	PrimaryComponentTick.TickGroup = TG_PostPhysics;
 	// ...
 }
 
@@ -34,97 +37,352 @@ void UVoroTestComponent::BeginPlay()
 
 void UVoroTestComponent::DestructMesh(const float Energy)
 {
-	UpdateGraphWeight(Energy, FEMComponent->CurrentImpactPoint);
+	DestructMeshWithMode(Energy, SplitMode);
+}
+
+void UVoroTestComponent::DestructMeshWithMode(const float Energy, const ESplitMode Mode)
+{
+	// 이전 파괴가 아직 진행 중
+	if (IsDestructionInProgress())
+		return;
+
+	// 스케줄러가 있으면 요청만 제출하고 프레임 예산에 맞춰 단계별로 실행되게 함
+	if (bUseScheduler)
+	{
+		if (UDestructionSchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UDestructionSchedulerSubsystem>())
+		{
+			bDestructionScheduled = Scheduler->Submit(this, Energy, Mode);
+			return;
+		}
+	}
+
+	TMap<uint32, DistOutEntry> DistanceMap;
+	ComputeRegions(Energy, FEMComponent->GetCurrentImpact(), GetOwner()->GetActorScale3D(), DistanceMap);
+
+	//VisualizeVertices();
+	DestroyActor(&DistanceMap, Mode);
+}
+
+// 무거운 단계는 워커 스레드의 태스크 파이프라인으로 실행하고, 조각 생성만 게임 스레드에서 수행
+// 파이프라인 도중 컴포넌트가 EndPlay되면 취소되고 OnFinished에 false 전달
+void UVoroTestComponent::DestructMeshAsync(const float Energy, const ESplitMode Mode, FOnDestructionFinished OnFinished)
+{
+	UStaticMeshComponent* MeshComponent = GetOwner()->FindComponentByClass<UStaticMeshComponent>();
+	const UStaticMesh* Mesh = MeshComponent ? MeshComponent->GetStaticMesh() : nullptr;
+	if (IsDestructionInProgress() || !Mesh || !FEMComponent)
+	{
+		OnFinished.ExecuteIfBound(false);
+		return;
+	}
+
+	TSharedRef<FDestructionJob> Job = LaunchWorkerStages(Energy, FEMComponent->GetCurrentImpact(), Mode, FDestructionQuality(), Mesh);
+
+	TWeakObjectPtr<UVoroTestComponent> WeakThis(this);
+	TWeakObjectPtr<UFEMCalculateComponent> WeakFEM(FEMComponent);
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakThis, WeakFEM, Job, OnFinished]()
+		{
+			UVoroTestComponent* This = WeakThis.Get();
+			if (!This || Job->bCancelled)
+			{
+				// 워커 단계가 모두 끝났으므로 충격을 다시 받음
+				if (UFEMCalculateComponent* FEM = WeakFEM.Get())
+					FEM->bDestructionLocked = false;
+				OnFinished.ExecuteIfBound(false);
+				return;
+			}
+
+			This->FinishJob(*Job);
+			OnFinished.ExecuteIfBound(true);
+		}, UE::Tasks::Prerequisites(Job->WorkerStages), LowLevelTasks::ETaskPriority::Normal, UE::Tasks::EExtendedTaskPriority::GameThreadNormalPri);
+}
+
+// 워커 단계는 여기서 복사한 충격 정보만 사용. 작업이 끝날 때까지 FEM은 Graph를 덮어쓸 새 충격을 거부
+TSharedRef<UVoroTestComponent::FDestructionJob> UVoroTestComponent::LaunchWorkerStages(const float Energy, const FFEMImpact& Impact, const ESplitMode Mode, const FDestructionQuality& Quality, const UStaticMesh* Mesh)
+{
+	TSharedRef<FDestructionJob> Job = MakeShared<FDestructionJob>();
+	Job->Impact = Impact;
+	Job->Mode = Quality.bForceTetGranular ? ESplitMode::TetGranular : Mode;
+	Job->Quality = Quality;
+	Job->Mesh = Mesh;
+	Job->OwnerScale = GetOwner()->GetActorScale3D();
+	Job->bSplitOnWorker = bUseDynamicMeshOutput;
+	FEMComponent->bDestructionLocked = true;
+	ActiveJob = Job;
+
+	UE::Tasks::FTask RegionTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [this, Job, Energy]()
+		{
+			if (Job->bCancelled)
+				return;
+
+			const double StartTime = FPlatformTime::Seconds();
+			ComputeRegions(Energy, Job->Impact, Job->OwnerScale, Job->DistanceMap, Job->Quality, &Job->bCancelled);
+			Job->RegionsMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+		});
+
+	Job->WorkerStages = UE::Tasks::Launch(UE_SOURCE_LOCATION, [this, Job]()
+		{
+			if (Job->bCancelled || !Job->bSplitOnWorker)
+				return;
+
+			const double StartTime = FPlatformTime::Seconds();
+			BuildPendingFragments(&Job->DistanceMap, Job->Mode, Job->Mesh, Job->OwnerScale, Job->Fragments, &Job->bCancelled);
+			Job->SplitMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+		}, UE::Tasks::Prerequisites(RegionTask));
+
+	return Job;
+}
+
+void UVoroTestComponent::FinishJob(FDestructionJob& Job)
+{
+	check(IsInGameThread());
+
+	if (FEMComponent)
+		FEMComponent->bDestructionLocked = false;
+	if (ActiveJob.Get() == &Job)
+		ActiveJob.Reset();
+
+	if (!Job.bSplitOnWorker)
+		BuildPendingFragments(&Job.DistanceMap, Job.Mode, Job.Mesh, Job.OwnerScale, Job.Fragments);
+	SpawnPendingFragments(MoveTemp(Job.Fragments));
+}
+
+int32 UVoroTestComponent::RunDestructionStages(const float Energy, const ESplitMode Mode)
+{
+	UStaticMeshComponent* MeshComponent = GetOwner()->FindComponentByClass<UStaticMeshComponent>();
+	const UStaticMesh* Mesh = MeshComponent ? MeshComponent->GetStaticMesh() : nullptr;
+
+	// 프로시저럴 경로는 NewObject가 필요해 워커에서 돌릴 수 없음
+	if (!Mesh || !FEMComponent || !bUseDynamicMeshOutput || IsDestructionInProgress())
+		return INDEX_NONE;
+	if (FEMComponent->CurrentImpactPoint.Num() == 0 && !bUseRandomSeed && !bUseStrainEnergyWeight)
+		return INDEX_NONE;
+
+	TMap<uint32, DistOutEntry> DistanceMap;
+	ComputeRegions(Energy, FEMComponent->GetCurrentImpact(), GetOwner()->GetActorScale3D(), DistanceMap);
+
+	TArray<FPendingFragment> Fragments;
+	BuildPendingFragments(&DistanceMap, Mode, Mesh, GetOwner()->GetActorScale3D(), Fragments);
+	return Fragments.Num();
+}
+
+bool UVoroTestComponent::IsDestructionInProgress() const
+{
+	return bSpawningFragments || bDestructionScheduled || ActiveJob.IsValid();
+}
+
+void UVoroTestComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// 워커 단계가 이 컴포넌트와 FEM 데이터를 참조하므로 끝날 때까지 대기. 취소 플래그는 CVT 반복마다,
+	// 다익스트라는 1024개 정점을 꺼낼 때마다, 분할은 영역마다 확인하므로 대기는 그 한 묶음 길이로 제한됨
+	if (ActiveJob.IsValid())
+	{
+		ActiveJob->bCancelled = true;
+		ActiveJob->WorkerStages.Wait();
+		ActiveJob.Reset();
+		if (FEMComponent)
+			FEMComponent->bDestructionLocked = false;
+	}
+
+	// 점진 생성 도중 소유 액터가 사라지면 숨겨 둔 조각은 원본 없이 남으므로 Despawn.
+	// 이미 공개된 조각은 그대로 두고 아직 만들지 않은 조각과 메쉬 참조는 버림
+	if (bSpawningFragments)
+	{
+		for (const TWeakObjectPtr<ASplitActor>& Fragment : UnrevealedFragments)
+		{
+			if (ASplitActor* Actor = Fragment.Get())
+				Actor->Despawn();
+		}
+		UnrevealedFragments.Empty();
+		PendingFragments.Empty();
+		PendingProceduralMeshes.Empty();
+		NumFragmentsToReveal = 0;
+		bSpawningFragments = false;
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+// 그래프 가중치 갱신, 시드 선택, CVT, 거리 계산, 작은 영역 병합. 게임 스레드 객체를 건드리지 않음
+// 충격 정보는 FEMComponent의 Current* 대신 호출자가 넘긴 복사본만 사용
+bool UVoroTestComponent::ComputeRegions(const float Energy, const FFEMImpact& Impact, const FVector& OwnerScale, TMap<uint32, DistOutEntry>& DistanceMap, const FDestructionQuality& Quality, const std::atomic<bool>* Cancel)
+{
+	auto IsCancelled = [Cancel]() { return Cancel && Cancel->load(std::memory_order_relaxed); };
+
+	// 품질 저하 시 시드 수를 줄이고 CVT 생략. 워커 스레드에서도 호출되므로 SeedNum은 읽기만 함
+	const uint32 SeedCount = FMath::Max(1u, (uint32)FMath::CeilToInt(SeedNum * Quality.SeedScale));
+	const bool bRunCVT = bUseCVT && Quality.bAllowCVT;
+
+	if (bUseStrainEnergyWeight)
+	{
+		FEMComponent->UpdateGraphWeightFromImpact(Impact);
+		VertexEnergy = FEMComponent->VertexStrainEnergy;
+	}
+	else
+		UpdateGraphWeight(Energy, Impact.ImpactPoints);
+
+	if (IsCancelled())
+		return false;
+
+	// RandomSeed가 지정되면 같은 충격에 대해 항상 같은 시드가 나오도록 매 파괴마다 스트림 초기화
+	// 0이면 시각과 인스턴스로 섞어 파괴마다, 액터마다 다른 결과 (워커 스레드에서도 호출되므로 전역 rand 대신 사용)
+	const int32 StreamSeed = RandomSeed != 0 ? RandomSeed : (int32)HashCombine(GetTypeHash(FPlatformTime::Cycles64()), PointerHash(this));
+	SeedStream.Initialize(StreamSeed);
 	if (bUseRandomSeed)
-		Seeds = getVoronoiSeedByRandom();
+		Seeds = getVoronoiSeedByRandom(SeedCount);
+	else if (bUseEnergySeedSampling)
+		Seeds = getVoronoiSeedByEnergy(SeedCount);
 	else
-		Seeds = getVoronoiSeedByImpactPoint(FEMComponent->CurrentImpactPoint);
+		Seeds = getVoronoiSeedByImpactPoint(Impact.ImpactPoints, SeedCount);
+
+	bool bDistanceReady = false;
 
-	if (bUseCVT)
+	if (bRunCVT)
 	{
 		CVT CVT_inst;
+		CVT_inst.CancelFlag = Cancel;
 
 		CVT_inst.SetVertices(FEMComponent->TetMeshVertices);
-		CVT_inst.SetVoronoiSites(Seeds);
-		CVT_inst.Lloyd_Algo();
+		if (CVTSolver == ECVTSolver::Geodesic)
+		{
+			// 그래프 거리 영역에서 바로 로이드 반복. 마지막 거리 필드를 분할에 그대로 사용
+			CVT_inst.Sites = Seeds;
+			CVT_inst.Geodesic_Lloyd_Algo(FEMComponent->Graph, 3);
+			DistanceMap = CVT_inst.GetDistanceMap();
+			bDistanceReady = true;
+		}
+		else
+		{
+			CVT_inst.SetVoronoiSites(Seeds);
+			if (CVTSolver == ECVTSolver::Anderson)
+				CVT_inst.Anderson_Lloyd_Algo();
+			else
+				CVT_inst.Lloyd_Algo();
+		}
 		Seeds = CVT_inst.Sites;
 		Region = CVT_inst.Region;
+
+		if (IsCancelled())
+			return false;
 	}
 
 	Region.Empty();
 	Region.AddUninitialized(FEMComponent->TetMeshVertices.Num());
 
-	DistanceCalculate DistCalc;
-	TMap<uint32, DistOutEntry> DistanceMap;
-	DistanceMap = DistCalc.Calculate(FEMComponent->Graph, Seeds, 3);
+	if (!bDistanceReady)
+	{
+		DistanceCalculate DistCalc;
+		DistCalc.CancelFlag = Cancel;
+		DistanceMap = DistCalc.Calculate(FEMComponent->Graph, Seeds, 3);
+		if (IsCancelled())
+			return false;
+	}
+
+	MergeSmallRegions(DistanceMap, OwnerScale);
 
 	for (const TPair<uint32, DistOutEntry>& dist : DistanceMap)
 		Region[dist.Key] = Seeds.Find(dist.Value.Source);
-
-	//VisualizeVertices();
-	DestroyActor(&DistanceMap);
+	return true;
 }
 
 void UVoroTestComponent::UpdateGraphWeight(const float Energy, const TArray<uint32> ImpactPoint)
 {
 	WeightedGraph* Graph = &(FEMComponent->Graph);
-	TSet<uint32> VisitedVertex;
-	TSet<uint32> NextVertexLayer;
-	TMap<uint32, float> EnergyMap;
-	TMap<uint32, uint32> EnergyMap_Contributed;
+	const int32 NumVertices = FEMComponent->TetMeshVertices.Num();
 
 	const float FACTOR_DIST_DAMPING = 0.01f;
-	
-	for (uint32 i = 0; i < Graph->size(); ++i)
-	{
-		EnergyMap.Add(i, 0);
-		EnergyMap_Contributed.Add(i, 0);
-	}
+	const float EnergyCutoff = Energy * EnergyCutoffRatio;
 
-	NextVertexLayer.Append(ImpactPoint);
-	EnergyMap[ImpactPoint[0]] = Energy;
-	EnergyMap[ImpactPoint[1]] = Energy;
-	EnergyMap[ImpactPoint[2]] = Energy;
+	// 버텍스별 평탄 배열: 에너지, 방문한 레이어 (INDEX_NONE = 미방문)
+	VertexEnergy.Init(0.f, NumVertices);
+	TArray<int32> VisitedLayer;
+	VisitedLayer.Init(INDEX_NONE, NumVertices);
 
-	EnergyMap_Contributed[ImpactPoint[0]] = 1;
-	EnergyMap_Contributed[ImpactPoint[1]] = 1;
-	EnergyMap_Contributed[ImpactPoint[2]] = 1;
+	// 이중 버퍼 Frontier. 한 번만 할당하고 레이어마다 교대로 사용
+	TArray<uint32> CurFrontier;
+	TArray<uint32> NextFrontier;
+	TArray<uint32> TouchedVertices;
+	CurFrontier.Reserve(NumVertices);
+	NextFrontier.Reserve(NumVertices);
+
+	for (const uint32 vtx : ImpactPoint)
+	{
+		if (VisitedLayer[vtx] != INDEX_NONE)
+			continue;
+		VisitedLayer[vtx] = 0;
+		VertexEnergy[vtx] = Energy;
+		CurFrontier.Add(vtx);
+	}
+	TouchedVertices.Append(CurFrontier);
 
 	// Calc Vertex Energy
-	while(!NextVertexLayer.IsEmpty())
+	int32 Layer = 0;
+	while (!CurFrontier.IsEmpty())
 	{
-		TSet<uint32> CurVertexLayer = NextVertexLayer;
-		VisitedVertex.Append(CurVertexLayer);
-		NextVertexLayer.Empty();
+		// 1) 다음 레이어 수집. 컷오프 미만 버텍스는 더 이상 전파하지 않음
+		std::atomic<int32> NextCount(0);
+		NextFrontier.SetNumUninitialized(NumVertices, EAllowShrinking::No);
+		ParallelFor(CurFrontier.Num(), [&](int32 i)
+			{
+				const uint32 vtx = CurFrontier[i];
+				if (VertexEnergy[vtx] < EnergyCutoff)
+					return;
 
-		for (const auto vtx : CurVertexLayer)
-		{
-			TArray<Link> links = Graph->getLinks(vtx);
-			for (const auto& link : links)
+				for (const Link& link : *Graph->findLinks(vtx))
+				{
+					// 먼저 도달한 스레드만 다음 레이어에 추가
+					if (FPlatformAtomics::InterlockedCompareExchange(&VisitedLayer[link.VertexIndex], Layer + 1, INDEX_NONE) == INDEX_NONE)
+						NextFrontier[NextCount.fetch_add(1)] = link.VertexIndex;
+				}
+			});
+		NextFrontier.SetNum(NextCount.load(), EAllowShrinking::No);
+
+		// 2) 이전 레이어 이웃으로부터 감쇠된 에너지를 모아 평균 (버텍스마다 자기 값만 기록하므로 동기화 불필요)
+		ParallelFor(NextFrontier.Num(), [&](int32 i)
 			{
-				// 방문하지 않은 노드라면
-				if (!VisitedVertex.Contains(link.VertexIndex))
+				const uint32 vtx = NextFrontier[i];
+				float EnergySum = 0.f;
+				int32 Contributed = 0;
+
+				for (const Link& link : *Graph->findLinks(vtx))
 				{
-					EnergyMap[link.VertexIndex] += EnergyMap[vtx] / (1 + link.linkVector.Size() * FACTOR_DIST_DAMPING);
-					EnergyMap_Contributed[link.VertexIndex]++;
-					NextVertexLayer.Emplace(link.VertexIndex);
+					const uint32 Prev = link.VertexIndex;
+					if (VisitedLayer[Prev] == Layer && VertexEnergy[Prev] >= EnergyCutoff)
+					{
+						EnergySum += VertexEnergy[Prev] / (1 + link.linkVector.Size() * FACTOR_DIST_DAMPING);
+						Contributed++;
+					}
 				}
-			}
-		}
-		for (const auto vtx : NextVertexLayer)
-			EnergyMap[vtx] = EnergyMap[vtx] / EnergyMap_Contributed[vtx];
+				VertexEnergy[vtx] = Contributed > 0 ? EnergySum / Contributed : 0.f;
+			});
+
+		TouchedVertices.Append(NextFrontier);
+		Swap(CurFrontier, NextFrontier);
+		++Layer;
+	}
 
-		// Update Graph Weight
-		for (const auto vtx : CurVertexLayer)
+	// Update Graph Weight
+	// 각 버텍스는 자기 인접 리스트만 갱신. 미방문 이웃 쪽의 역방향 링크는 서로 다른 원소이므로 경합 없음
+	ParallelFor(TouchedVertices.Num(), [&](int32 i)
 		{
-			TArray<Link> links = Graph->getLinks(vtx);
-			for (const auto& link : links)
+			const uint32 vtx = TouchedVertices[i];
+			for (Link& link : *Graph->findLinks(vtx))
 			{
-				float NewWeight = (EnergyMap[link.VertexIndex] + EnergyMap[vtx]) / 2;
-				Graph->updateLink(vtx, link.VertexIndex, NewWeight);
+				const float NewWeight = (VertexEnergy[link.VertexIndex] + VertexEnergy[vtx]) / 2;
+				link.weight = NewWeight;
+
+				if (VisitedLayer[link.VertexIndex] == INDEX_NONE)
+				{
+					for (Link& reverse : *Graph->findLinks(link.VertexIndex))
+					{
+						if (reverse.VertexIndex == vtx)
+						{
+							reverse.weight = NewWeight;
+							break;
+						}
+					}
+				}
 			}
-		}
-	}
+		});
 	
 	// Visualize Vertex Energy
 	/*
@@ -133,8 +391,8 @@ void UVoroTestComponent::UpdateGraphWeight(const float Energy, const TArray<uint
 		FVector WorldPosition = GetOwner()->GetActorTransform().TransformPosition(static_cast<FVector>(FEMComponent->TetMeshVertices[i]));
 
 		FColor color = FColor::Black;
-		color.G = 255 * (1 - EnergyMap[i] / Energy);
-		color.R = 255 * EnergyMap[i] / Energy;
+		color.G = 255 * (1 - VertexEnergy[i] / Energy);
+		color.R = 255 * VertexEnergy[i] / Energy;
 
 		DrawDebugPoint(GetWorld(), WorldPosition, 15.0f, color, true, -1.0f, 0);
 	}
@@ -149,22 +407,74 @@ void UVoroTestComponent::UpdateGraphWeight(const float Energy, const TArray<uint
 void UVoroTestComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if (QueuedImpacts.Num() > 0)
+		ResolveQueuedImpacts();
+
+	if (bSpawningFragments)
+		UpdateProgressiveSpawn();
+}
+
+void UVoroTestComponent::QueueImpact(const FVector& Velocity, const FVector& NextTickVelocity, const float Mass, const FVector& HitPoint)
+{
+	QueuedImpacts.Add({ Velocity, NextTickVelocity, Mass, HitPoint });
+}
+
+void UVoroTestComponent::ResolveQueuedImpacts()
+{
+	// 이미 파괴 중이면 원본이 곧 사라지므로 버림
+	if (!FEMComponent || IsDestructionInProgress())
+	{
+		QueuedImpacts.Reset();
+		return;
+	}
+
+	float TotalEnergy = 0.f;
+	float WeightSum = 0.f;
+	FVector ForceSum = FVector::ZeroVector;
+	FVector WeightedHitPoint = FVector::ZeroVector;
+	TArray<uint32> ImpactPoints;
+
+	for (const FQueuedImpact& Impact : QueuedImpacts)
+	{
+		const float Energy = FEMComponent->CalculateEnergyAtTatUsingFEM(Impact.Velocity, Impact.NextTickVelocity, Impact.Mass, Impact.HitPoint);
+		TotalEnergy += Energy;
+
+		for (const uint32 Vertex : FEMComponent->CurrentImpactPoint)
+			ImpactPoints.AddUnique(Vertex);
+
+		// 변형 에너지 경로(Kelvin 변위장)는 합력과 에너지 가중 평균 지점을 하나의 점하중으로 사용
+		const float Weight = FMath::Max(Energy, UE_SMALL_NUMBER);
+		ForceSum += FEMComponent->CurrentImpactForce;
+		WeightedHitPoint += Impact.HitPoint * Weight;
+		WeightSum += Weight;
+	}
+	QueuedImpacts.Reset();
+
+	if (TotalEnergy < DestructionThreshold)
+		return;
+
+	FEMComponent->CurrentImpactPoint = MoveTemp(ImpactPoints);
+	FEMComponent->CurrentImpactForce = ForceSum;
+	FEMComponent->CurrentHitPoint = WeightedHitPoint / WeightSum;
+
+	DestructMesh(TotalEnergy);
 }
 
-TArray<uint32> UVoroTestComponent::getVoronoiSeedByImpactPoint(const TArray<uint32> ImpactPoint)
+TArray<uint32> UVoroTestComponent::getVoronoiSeedByImpactPoint(const TArray<uint32> ImpactPoint, const uint32 SeedCount)
 {
 	WeightedGraph* Graph = &(FEMComponent->Graph);
 	TArray<uint32> VoronoiSeeds;
 	TSet<uint32> VisitedVertex;
 	TSet<uint32> NextVertexLayer;
 	
-	if (SeedNum <= 3)
-		VoronoiSeeds = getRandomElementsFromArray(ImpactPoint, SeedNum);
+	if (SeedCount <= 3)
+		VoronoiSeeds = getRandomElementsFromArray(ImpactPoint, SeedCount);
 	else
 	{
 		// 그래프 순회하며 주변 버텍스 선택
 		NextVertexLayer.Append(ImpactPoint);
-		while ((uint32)VoronoiSeeds.Num() < SeedNum)
+		while ((uint32)VoronoiSeeds.Num() < SeedCount)
 		{
 			TSet<uint32> CurVertexLayer = NextVertexLayer;
 			VisitedVertex.Append(CurVertexLayer);
@@ -179,8 +489,8 @@ TArray<uint32> UVoroTestComponent::getVoronoiSeedByImpactPoint(const TArray<uint
 						NextVertexLayer.Emplace(link.VertexIndex);
 				}
 			}
-			if ((uint32)(NextVertexLayer.Num() + VoronoiSeeds.Num()) > SeedNum)
-				VoronoiSeeds.Append(getRandomElementsFromArray(NextVertexLayer.Array(), SeedNum - VoronoiSeeds.Num()));
+			if ((uint32)(NextVertexLayer.Num() + VoronoiSeeds.Num()) > SeedCount)
+				VoronoiSeeds.Append(getRandomElementsFromArray(NextVertexLayer.Array(), SeedCount - VoronoiSeeds.Num()));
 			else
 				VoronoiSeeds.Append(NextVertexLayer.Array());
 		}
@@ -190,17 +500,21 @@ TArray<uint32> UVoroTestComponent::getVoronoiSeedByImpactPoint(const TArray<uint
 	return VoronoiSeeds;
 }
 
-TArray<uint32> UVoroTestComponent::getVoronoiSeedByRandom()
+TArray<uint32> UVoroTestComponent::getVoronoiSeedByRandom(const uint32 SeedCount)
 {
 	TArray<uint32> VoronoiSeeds;
 	TSet<uint32> SelectedIndices;
-	int32 VeticesSize = FEMComponent->TetMeshVertices.Num();
+	const uint32 VeticesSize = FEMComponent->TetMeshVertices.Num();
+	const uint32 NumSeeds = FMath::Min(SeedCount, VeticesSize);
 
-	while ((uint32)SelectedIndices.Num() < SeedNum)
+	// Floyd 샘플링 : 중복 없이 정확히 NumSeeds 번만 난수 생성 (시드 수가 버텍스 수에 가까워도 재시도 없음)
+	for (uint32 j = VeticesSize - NumSeeds; j < VeticesSize; ++j)
 	{
-		// ���� �ε��� ����
-		uint32 RandomIndex = FMath::RandRange(0, VeticesSize - 1);
-		SelectedIndices.Emplace(RandomIndex);
+		const uint32 RandomIndex = (uint32)SeedStream.RandRange(0, (int32)j);
+		if (SelectedIndices.Contains(RandomIndex))
+			SelectedIndices.Emplace(j);
+		else
+			SelectedIndices.Emplace(RandomIndex);
 	}
 	VoronoiSeeds = SelectedIndices.Array();
 	VoronoiSeeds.Sort();
@@ -208,6 +522,134 @@ TArray<uint32> UVoroTestComponent::getVoronoiSeedByRandom()
 	return VoronoiSeeds;
 }
 
+// 전파된 에너지 필드 기반 Poisson-disk 시드 샘플링
+// 에너지가 높을수록 최소 간격을 줄여 충격 지점 주변에 시드를 촘촘히 배치하고,
+// 공간 해시 격자로 주변 시드와의 간격만 검사
+TArray<uint32> UVoroTestComponent::getVoronoiSeedByEnergy(const uint32 SeedCount)
+{
+	const TArray<FVector>& Vertices = FEMComponent->TetMeshVertices;
+	const int32 NumVertices = Vertices.Num();
+	const int32 NumSeeds = FMath::Min((int32)SeedCount, NumVertices);
+	const float MinRadiusScale = 0.35f;
+
+	float MaxEnergy = 0.f;
+	for (const float E : VertexEnergy)
+		MaxEnergy = FMath::Max(MaxEnergy, E);
+
+	// 후보 : 에너지가 전달된 버텍스. 부족하면 전체 버텍스
+	TArray<int32> Candidates;
+	for (int32 i = 0; i < VertexEnergy.Num(); ++i)
+		if (VertexEnergy[i] > 0.f)
+			Candidates.Add(i);
+
+	if (Candidates.Num() < NumSeeds || MaxEnergy <= 0.f)
+	{
+		Candidates.SetNumUninitialized(NumVertices);
+		for (int32 i = 0; i < NumVertices; ++i)
+			Candidates[i] = i;
+	}
+
+	auto NormalizedEnergy = [&](const int32 Vertex)
+		{
+			return MaxEnergy > 0.f && Vertex < VertexEnergy.Num() ? VertexEnergy[Vertex] / MaxEnergy : 0.f;
+		};
+
+	// 에너지 가중 무작위 순서 (Efraimidis-Spirakis : key = ln(u) / w 가 클수록 먼저)
+	TArray<TPair<float, int32>> Order;
+	Order.Reserve(Candidates.Num());
+	for (const int32 Vertex : Candidates)
+	{
+		const float Weight = NormalizedEnergy(Vertex) + KINDA_SMALL_NUMBER;
+		const float U = FMath::Max(SeedStream.GetFraction(), KINDA_SMALL_NUMBER);
+		Order.Emplace(FMath::Loge(U) / Weight, Vertex);
+	}
+	Order.Sort([](const TPair<float, int32>& A, const TPair<float, int32>& B) { return A.Key > B.Key; });
+
+	// 후보 영역을 시드 수로 나눈 격자 간격을 최대 반경으로 사용
+	FBox Bounds(ForceInit);
+	for (const int32 Vertex : Candidates)
+		Bounds += Vertices[Vertex];
+	const FVector Size = Bounds.GetSize().ComponentMax(FVector(Bounds.GetSize().GetMax() * 0.01));
+	float Radius = FMath::Max((float)FMath::Pow(Size.X * Size.Y * Size.Z / NumSeeds, 1.0 / 3.0), KINDA_SMALL_NUMBER);
+
+	TArray<int32> Selected;
+	TSet<int32> SelectedSet;
+	TMap<FIntVector, TArray<int32, TInlineAllocator<4>>> Grid;
+
+	auto CellOf = [&](const FVector& Position)
+		{
+			return FIntVector(FMath::FloorToInt(Position.X / Radius), FMath::FloorToInt(Position.Y / Radius), FMath::FloorToInt(Position.Z / Radius));
+		};
+
+	// 반경이 클수록 간격이 넓음. 목표 개수를 못 채우면 반경을 줄이되 이미 뽑힌 시드는 유지
+	for (int32 Pass = 0; Pass < 8 && Selected.Num() < NumSeeds; ++Pass)
+	{
+		Grid.Reset();
+		for (const int32 Vertex : Selected)
+			Grid.FindOrAdd(CellOf(Vertices[Vertex])).Add(Vertex);
+
+		for (const TPair<float, int32>& Entry : Order)
+		{
+			if (Selected.Num() >= NumSeeds)
+				break;
+
+			const int32 Vertex = Entry.Value;
+			if (SelectedSet.Contains(Vertex))
+				continue;
+
+			const FVector& Position = Vertices[Vertex];
+			const float LocalRadius = Radius * FMath::Lerp(1.f, MinRadiusScale, NormalizedEnergy(Vertex));
+			const FIntVector Cell = CellOf(Position);
+
+			bool bConflict = false;
+			for (int32 dx = -1; dx <= 1 && !bConflict; ++dx)
+				for (int32 dy = -1; dy <= 1 && !bConflict; ++dy)
+					for (int32 dz = -1; dz <= 1 && !bConflict; ++dz)
+					{
+						const auto* Bucket = Grid.Find(Cell + FIntVector(dx, dy, dz));
+						if (!Bucket)
+							continue;
+
+						for (const int32 Other : *Bucket)
+						{
+							const float OtherRadius = Radius * FMath::Lerp(1.f, MinRadiusScale, NormalizedEnergy(Other));
+							if (FVector::DistSquared(Position, Vertices[Other]) < FMath::Square(0.5f * (LocalRadius + OtherRadius)))
+							{
+								bConflict = true;
+								break;
+							}
+						}
+					}
+
+			if (bConflict)
+				continue;
+
+			Selected.Add(Vertex);
+			SelectedSet.Add(Vertex);
+			Grid.FindOrAdd(Cell).Add(Vertex);
+		}
+
+		Radius *= 0.7f;
+	}
+
+	// 그래도 부족하면 가중 순서대로 채움
+	for (int32 i = 0; i < Order.Num() && Selected.Num() < NumSeeds; ++i)
+	{
+		if (!SelectedSet.Contains(Order[i].Value))
+		{
+			Selected.Add(Order[i].Value);
+			SelectedSet.Add(Order[i].Value);
+		}
+	}
+
+	TArray<uint32> VoronoiSeeds;
+	for (const int32 Vertex : Selected)
+		VoronoiSeeds.Add((uint32)Vertex);
+	VoronoiSeeds.Sort();
+
+	return VoronoiSeeds;
+}
+
 void UVoroTestComponent::VisualizeVertices()
 {
 	for (int32 i = 0; i < FEMComponent->TetMeshVertices.Num(); i++)
@@ -224,7 +666,114 @@ void UVoroTestComponent::VisualizeVertices()
 	}
 }
 
-void UVoroTestComponent::DestroyActor(const TMap<uint32, DistOutEntry>* Dist)
+// 부피가 MinFragmentVolume 미만인 영역을 그래프상 인접한 영역 중 가장 큰 영역에 병합
+// 작은 영역부터 처리하며, 병합 결과는 DistanceMap의 Source를 바꿔 반영
+void UVoroTestComponent::MergeSmallRegions(TMap<uint32, DistOutEntry>& DistanceMap, const FVector& OwnerScale)
+{
+	const int32 NumRegions = Seeds.Num();
+	if (MinFragmentVolume <= 0.f || NumRegions < 2)
+		return;
+
+	const TArray<FVector>& Vertices = FEMComponent->TetMeshVertices;
+
+	TArray<int32> VertexRegion;
+	VertexRegion.Init(INDEX_NONE, Vertices.Num());
+	for (const TPair<uint32, DistOutEntry>& dist : DistanceMap)
+	{
+		if (VertexRegion.IsValidIndex(dist.Key))
+			VertexRegion[dist.Key] = Seeds.Find(dist.Value.Source);
+	}
+
+	// 영역 부피: 사면체 부피를 네 정점이 속한 영역에 1/4씩 분배. DebrisVolumeThreshold와 같이 월드 스케일 기준
+	const double ScaleVolume = FMath::Abs(OwnerScale.X * OwnerScale.Y * OwnerScale.Z);
+	TArray<double> Volume;
+	Volume.Init(0.0, NumRegions);
+	for (const FIntVector4& Tet : FEMComponent->Tets)
+	{
+		const FVector& A = Vertices[Tet[0]];
+		const double TetVolume = FMath::Abs(FVector::DotProduct(Vertices[Tet[1]] - A, FVector::CrossProduct(Vertices[Tet[2]] - A, Vertices[Tet[3]] - A))) / 6.0;
+		for (int32 i = 0; i < 4; ++i)
+		{
+			if (VertexRegion[Tet[i]] != INDEX_NONE)
+				Volume[VertexRegion[Tet[i]]] += TetVolume * ScaleVolume / 4.0;
+		}
+	}
+
+	// 영역 인접: 서로 다른 영역의 두 정점을 잇는 그래프 에지
+	TArray<TSet<int32>> Neighbors;
+	Neighbors.SetNum(NumRegions);
+	for (int32 v = 0; v < Vertices.Num(); ++v)
+	{
+		const int32 R = VertexRegion[v];
+		const TArray<Link>* Links = FEMComponent->Graph.findLinks(v);
+		if (R == INDEX_NONE || !Links)
+			continue;
+
+		for (const Link& link : *Links)
+		{
+			const int32 S = VertexRegion[link.VertexIndex];
+			if (S != INDEX_NONE && S != R)
+				Neighbors[R].Add(S);
+		}
+	}
+
+	TArray<int32> Parent;
+	TArray<int32> Order;
+	for (int32 r = 0; r < NumRegions; ++r)
+	{
+		Parent.Add(r);
+		Order.Add(r);
+	}
+	Order.Sort([&Volume](const int32 A, const int32 B) { return Volume[A] < Volume[B]; });
+
+	auto FindRoot = [&Parent](int32 r)
+	{
+		while (Parent[r] != r)
+		{
+			Parent[r] = Parent[Parent[r]];
+			r = Parent[r];
+		}
+		return r;
+	};
+
+	int32 NumMerged = 0;
+	for (const int32 r : Order)
+	{
+		// 이미 다른 영역에 병합되었거나 (흡수로) 충분히 커진 영역은 유지
+		if (FindRoot(r) != r || Volume[r] >= MinFragmentVolume)
+			continue;
+
+		int32 Target = INDEX_NONE;
+		for (const int32 n : Neighbors[r])
+		{
+			const int32 Root = FindRoot(n);
+			if (Root != r && (Target == INDEX_NONE || Volume[Root] > Volume[Target]))
+				Target = Root;
+		}
+
+		if (Target == INDEX_NONE)
+			continue;
+
+		Parent[r] = Target;
+		Volume[Target] += Volume[r];
+		Neighbors[Target].Append(Neighbors[r]);
+		++NumMerged;
+	}
+
+	if (NumMerged == 0)
+		return;
+
+	for (TPair<uint32, DistOutEntry>& dist : DistanceMap)
+	{
+		const int32 R = Seeds.Find(dist.Value.Source);
+		if (R != INDEX_NONE)
+			dist.Value.Source = Seeds[FindRoot(R)];
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("Merged %d regions smaller than %.1f cm^3"), NumMerged, MinFragmentVolume);
+}
+
+void UVoroTestComponent::DestroyActor(const TMap<uint32, DistOutEntry>* Dist, const ESplitMode Mode)
 {
 	UStaticMeshComponent* MeshComponent = GetOwner()->FindComponentByClass<UStaticMeshComponent>();
 	if (!MeshComponent)
@@ -233,7 +782,6 @@ void UVoroTestComponent::DestroyActor(const TMap<uint32, DistOutEntry>* Dist)
 		return;
 	}
 
-	TMap<uint32, UProceduralMeshComponent*> Meshes;
 	const UStaticMesh* Mesh = MeshComponent->GetStaticMesh();
 	if (!Mesh)
 	{
@@ -241,56 +789,229 @@ void UVoroTestComponent::DestroyActor(const TMap<uint32, DistOutEntry>* Dist)
 		return;
 	}
 
+	TArray<FPendingFragment> Pending;
+	BuildPendingFragments(Dist, Mode, Mesh, GetOwner()->GetActorScale3D(), Pending);
+	SpawnPendingFragments(MoveTemp(Pending));
+}
+
+// 거리 필드로 메쉬를 조각으로 분리. 동적 메쉬 출력이면 UObject를 만들지 않으므로 워커 스레드에서 호출 가능
+void UVoroTestComponent::BuildPendingFragments(const TMap<uint32, DistOutEntry>* Dist, const ESplitMode Mode, const UStaticMesh* Mesh, const FVector& OwnerScale, TArray<FPendingFragment>& OutPending, const std::atomic<bool>* Cancel) const
+{
 	auto MeshSplit = SplitMesh(Mesh, FEMComponent, Dist);
-	Meshes = MeshSplit.Split();
+	MeshSplit.MaxHullVertices = MaxCollisionHullVertices;
+	MeshSplit.CancelFlag = Cancel;
+
+	// 충돌 티어 기준 부피는 월드 단위이므로 스케일을 나눠 로컬 부피로 변환
+	const FVector Scale = OwnerScale.GetAbs();
+	const double LocalVolumeScale = FMath::Max(Scale.X * Scale.Y * Scale.Z, UE_DOUBLE_SMALL_NUMBER);
+	MeshSplit.SphereCollisionVolume = SphereCollisionVolume / LocalVolumeScale;
+	MeshSplit.BoxCollisionVolume = BoxCollisionVolume / LocalVolumeScale;
+	MeshSplit.SimplifiedHullVolume = SimplifiedHullVolume / LocalVolumeScale;
+	MeshSplit.SimplifiedHullVertices = SimplifiedHullVertices;
+	const bool bTetGranular = Mode == ESplitMode::TetGranular;
+
+	if (bUseDynamicMeshOutput)
+	{
+		TArray<FFragment> Fragments = MeshSplit.SplitFragments(bTetGranular);
+		for (FFragment& Fragment : Fragments)
+		{
+			FPendingFragment& Entry = OutPending.AddDefaulted_GetRef();
+			Entry.Fragment = MoveTemp(Fragment);
+		}
+	}
+	else
+	{
+		TMap<uint32, UProceduralMeshComponent*> Meshes = bTetGranular ? MeshSplit.SplitByTets() : MeshSplit.Split();
+		for (const TPair<uint32, UProceduralMeshComponent*>& Pair : Meshes)
+		{
+			FPendingFragment& Entry = OutPending.AddDefaulted_GetRef();
+			Entry.Fragment.Region = Pair.Key;
+			Entry.Fragment.Collision = MeshSplit.GetCollisions().FindRef(Pair.Key);
+			Entry.Fragment.MassProperties = MeshSplit.GetMassProperties().FindRef(Pair.Key);
+			Entry.ProceduralMesh = Pair.Value;
+		}
+	}
+}
 
+// 게임 스레드에서 조각을 파편 또는 액터로 생성하고 원본 제거
+void UVoroTestComponent::SpawnPendingFragments(TArray<FPendingFragment>&& Fragments)
+{
 	UWorld* World = GetWorld();
-	if (!World)
+	UStaticMeshComponent* MeshComponent = GetOwner()->FindComponentByClass<UStaticMeshComponent>();
+	if (!World || !MeshComponent)
 	{
 		UE_LOG(LogTemp, Error, TEXT("World is not valid! Cannot spawn actors."));
 		return;
 	}
 
-	TArray<uint32> key;
-	Meshes.GetKeys(key);
-	auto& PositionBuffer = Mesh->GetRenderData()->LODResources[0].VertexBuffers.PositionVertexBuffer;
-
-	if (key.Num() == 0)
+	if (Fragments.Num() == 0)
 	{
 		UE_LOG(LogTemp, Error, TEXT("Mesh to generate is not exist."));
 		return;
 	}
 
-	TArray<UMaterialInterface*> Materials;
-	for (int32 MaterialIndex = 0; MaterialIndex < MeshComponent->GetNumMaterials(); ++MaterialIndex)
+	const FTransform& OwnerTransform = GetOwner()->GetActorTransform();
+	const FVector OwnerScale = OwnerTransform.GetScale3D().GetAbs();
+	const TArray<UMaterialInterface*> SourceMaterials = MeshComponent->GetMaterials();
+	PendingMaterials = SourceMaterials;
+
+	// 부피가 DebrisVolumeThreshold 미만인 조각은 액터 대신 인스턴스 파편으로 생성
+	UDebrisSubsystem* Debris = DebrisVolumeThreshold > 0.f ? World->GetSubsystem<UDebrisSubsystem>() : nullptr;
+	auto TrySpawnDebris = [&](const FFragmentMassProperties& Properties, const uint32 RegionId) -> bool
 	{
-		UMaterialInterface* Material = MeshComponent->GetMaterial(MaterialIndex);
-		if (Material)
-		{
-			Materials.Add(Material);
-		}
+		const double Volume = Properties.Volume * OwnerScale.X * OwnerScale.Y * OwnerScale.Z;
+		if (!Debris || Properties.Volume <= 0.0 || Volume >= DebrisVolumeThreshold)
+			return false;
+
+		// 충격 지점에서 멀어지는 방향으로 날림
+		const FVector Direction = (Properties.CenterOfMass - FEMComponent->CurrentHitPoint).GetSafeNormal();
+		const FVector Velocity = OwnerTransform.TransformVectorNoScale(Direction) * DebrisSpeed;
+
+		const FTransform DebrisTransform(
+			OwnerTransform.GetRotation() * Properties.PrincipalRotation,
+			OwnerTransform.TransformPosition(Properties.CenterOfMass));
+		UMaterialInterface* Material = SourceMaterials.Num() > 0 ? SourceMaterials[0] : nullptr;
+		return Debris->SpawnDebris(DebrisTransform, (float)FMath::Pow(Volume, 1.0 / 3.0), Velocity, Material, RegionId);
+	};
+
+	TArray<FPendingFragment> Pending;
+	Pending.Reserve(Fragments.Num());
+	for (FPendingFragment& Entry : Fragments)
+	{
+		if (!TrySpawnDebris(Entry.Fragment.MassProperties, Entry.Fragment.Region))
+			Pending.Add(MoveTemp(Entry));
 	}
-	
-	for (int32 i = 0; i < key.Num(); ++i)
+
+	if (!bProgressiveSpawn)
 	{
-		FVector SpawnLocation = GetOwner()->GetActorLocation();
-		FRotator SpawnRotation = GetOwner()->GetActorRotation();
-		FVector SpawnScale = GetOwner()->GetActorScale();
+		for (FPendingFragment& Entry : Pending)
+			SpawnFragment(Entry);
+
+		GetOwner()->Destroy(true);
+		return;
+	}
+
+	// 카메라나 충격 지점에 가까운 조각부터 생성. 배열 끝에서 꺼내므로 먼 조각이 앞에 오도록 정렬
+	const FVector HitLocation = OwnerTransform.TransformPosition(FEMComponent->CurrentHitPoint);
+	FVector ViewLocation = HitLocation;
+	if (APlayerController* PC = World->GetFirstPlayerController())
+	{
+		FRotator ViewRotation;
+		PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+	}
 
+	for (FPendingFragment& Entry : Pending)
+	{
+		const FVector Center = OwnerTransform.TransformPosition(Entry.Fragment.MassProperties.CenterOfMass);
+		Entry.Priority = FMath::Min(FVector::Dist(Center, ViewLocation), FVector::Dist(Center, HitLocation));
+		if (Entry.ProceduralMesh)
+			PendingProceduralMeshes.Add(Entry.ProceduralMesh);
+	}
+	Pending.Sort([](const FPendingFragment& A, const FPendingFragment& B) { return A.Priority > B.Priority; });
+
+	PendingFragments = MoveTemp(Pending);
+	bSpawningFragments = true;
+	NumFragmentsToReveal = FMath::CeilToInt(PendingFragments.Num() * ProgressiveRevealRatio);
+	bFragmentsRevealed = false;
+
+	// 원본은 조각이 충분히 준비될 때까지 보이되, 조각과 충돌하지 않도록 충돌만 끔
+	GetOwner()->SetActorEnableCollision(false);
+	SetComponentTickEnabled(true);
+}
+
+ASplitActor* UVoroTestComponent::SpawnSplitActor()
+{
+	UWorld* World = GetWorld();
+	const FVector SpawnLocation = GetOwner()->GetActorLocation();
+	const FRotator SpawnRotation = GetOwner()->GetActorRotation();
+	const FVector SpawnScale = GetOwner()->GetActorScale();
+
+	ASplitActor* NewActor = nullptr;
+	if (USplitActorPool* Pool = World->GetSubsystem<USplitActorPool>())
+	{
+		NewActor = Pool->Acquire(FTransform(SpawnRotation, SpawnLocation, SpawnScale));
+	}
+	else
+	{
 		FActorSpawnParameters SpawnParams;
 		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
 
-		ASplitActor* NewActor = World->SpawnActor<ASplitActor>(ASplitActor::StaticClass(), SpawnLocation, SpawnRotation, SpawnParams);
-		if (!NewActor)
+		NewActor = World->SpawnActor<ASplitActor>(ASplitActor::StaticClass(), SpawnLocation, SpawnRotation, SpawnParams);
+		if (NewActor)
+			NewActor->SetActorScale3D(SpawnScale);
+	}
+
+	if (!NewActor)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to spawn actor at location: %s"), *SpawnLocation.ToString());
+		return nullptr;
+	}
+
+	NewActor->SetLifetime(FragmentLifetime);
+	if (UFragmentBudgetSubsystem* Budget = World->GetSubsystem<UFragmentBudgetSubsystem>())
+		Budget->RegisterFragment(NewActor);
+	return NewActor;
+}
+
+ASplitActor* UVoroTestComponent::SpawnFragment(FPendingFragment& Entry)
+{
+	ASplitActor* NewActor = SpawnSplitActor();
+	if (!NewActor)
+		return nullptr;
+
+	if (Entry.ProceduralMesh)
+	{
+		NewActor->SetProceduralMesh(Entry.ProceduralMesh, PendingMaterials);
+		NewActor->GenerateCollisionConvexMesh(Entry.Fragment.Collision.Hull);
+	}
+	else
+	{
+		NewActor->SetMesh(MoveTemp(Entry.Fragment.Mesh), PendingMaterials, Entry.Fragment.Collision);
+	}
+	NewActor->SetMassProperties(Entry.Fragment.MassProperties, FragmentDensity);
+	return NewActor;
+}
+
+void UVoroTestComponent::UpdateProgressiveSpawn()
+{
+	const double StartTime = FPlatformTime::Seconds();
+	const double Budget = ProgressiveSpawnBudgetMs * 0.001;
+
+	// 최소 한 개는 생성해 예산이 작아도 진행되도록 함
+	do
+	{
+		if (PendingFragments.Num() == 0)
+			break;
+
+		FPendingFragment Entry = PendingFragments.Pop(EAllowShrinking::No);
+		if (ASplitActor* NewActor = SpawnFragment(Entry))
 		{
-			UE_LOG(LogTemp, Error, TEXT("Failed to spawn actor at location: %s"), *SpawnLocation.ToString());
-			continue;
+			if (!bFragmentsRevealed)
+			{
+				// 공개 전까지 숨기고 물리를 멈춰 원본 메쉬만 보이게 함
+				NewActor->SetFragmentEnabled(false);
+				UnrevealedFragments.Add(NewActor);
+			}
 		}
+		--NumFragmentsToReveal;
+	} while (FPlatformTime::Seconds() - StartTime < Budget);
 
-		NewActor->SetActorScale3D(SpawnScale);
-		NewActor->SetProceduralMesh(Meshes.FindRef(key[i]), MeshComponent->GetMaterials());
-		NewActor->GenerateCollisionConvexMesh();
+	if (!bFragmentsRevealed && NumFragmentsToReveal <= 0)
+	{
+		for (const TWeakObjectPtr<ASplitActor>& Fragment : UnrevealedFragments)
+		{
+			if (ASplitActor* Actor = Fragment.Get())
+				Actor->SetFragmentEnabled(true);
+		}
+		UnrevealedFragments.Empty();
+		GetOwner()->SetActorHiddenInGame(true);
+		bFragmentsRevealed = true;
 	}
 
-	GetOwner()->Destroy(true);
-}
\ No newline at end of file
+	if (PendingFragments.Num() == 0)
+	{
+		bSpawningFragments = false;
+		PendingProceduralMeshes.Empty();
+		GetOwner()->Destroy(true);
+	}
+}
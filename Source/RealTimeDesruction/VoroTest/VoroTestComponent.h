@@ -9,17 +9,51 @@
 #include "../DistanceCalculate/DistanceCalculate.h"
 #include "../SplitMesh/SplitMesh.h"
 #include "../SplitActor/SplitActor.h"
+#include "../SplitActor/SplitActorPool.h"
+#include "../SplitActor/FragmentBudgetSubsystem.h"
+#include "../Debris/DebrisSubsystem.h"
 #include "Engine/StaticMeshActor.h"
 #include "ProceduralMeshConversion.h"
 #include "StaticMeshDescription.h"
+#include "Tasks/Task.h"
 #include "VoroTestComponent.generated.h"
 
+UENUM(BlueprintType)
+enum class ECVTSolver : uint8
+{
+	Lloyd		UMETA(DisplayName = "Lloyd"),
+	Anderson	UMETA(DisplayName = "Anderson Accelerated Lloyd"),
+	Geodesic	UMETA(DisplayName = "Geodesic Lloyd (Graph Distance)")
+};
+
+// 조각 경계 생성 방식. TetGranular는 사면체를 자르지 않고 사면체 면을 그대로 경계로 사용 (멀거나 중요도가 낮은 물체용)
+UENUM(BlueprintType)
+enum class ESplitMode : uint8
+{
+	Exact			UMETA(DisplayName = "Exact (Cut Tets)"),
+	TetGranular		UMETA(DisplayName = "Tet Granular (Fast)")
+};
+
+class UDestructionSchedulerSubsystem;
+
+// 파괴 품질. 스케줄러가 프레임 예산을 넘기면 낮춤
+struct FDestructionQuality
+{
+	bool bAllowCVT = true;
+	float SeedScale = 1.f;			// SeedNum에 곱하는 비율
+	bool bForceTetGranular = false;
+};
+
+// 비동기 파괴 완료 콜백. 취소되거나 시작하지 못하면 false
+DECLARE_DELEGATE_OneParam(FOnDestructionFinished, bool /*bSucceeded*/);
 
 UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
 class REALTIMEDESRUCTION_API UVoroTestComponent : public UActorComponent
 {
 	GENERATED_BODY()
 
+	friend class UDestructionSchedulerSubsystem;
+
 public:	
 	// Sets default values for this component's properties
 	UVoroTestComponent();
@@ -27,21 +61,118 @@ public:
 	UPROPERTY(EditAnywhere, Category = "Dataflow")
 	bool bUseCVT;
 
+	UPROPERTY(EditAnywhere, Category = "Dataflow", meta = (EditCondition = "bUseCVT"))
+	ECVTSolver CVTSolver = ECVTSolver::Lloyd;
+
+	// 충격 지점 주변 전파 대신 모든 사면체의 변형 에너지(FEM)로 그래프 가중치 계산
+	UPROPERTY(EditAnywhere, Category = "Dataflow")
+	bool bUseStrainEnergyWeight;
+
 	UPROPERTY(EditAnywhere, Category = "Dataflow")
 	bool bUseRandomSeed;
 
+	// 충격 에너지 필드 기반 Poisson-disk 시드 샘플링 (충격 지점 주변일수록 촘촘)
+	UPROPERTY(EditAnywhere, Category = "Dataflow", meta = (EditCondition = "!bUseRandomSeed"))
+	bool bUseEnergySeedSampling;
+
+	// 시드 선택용 난수 스트림의 시드값. 0이 아니면 같은 충격에 대해 항상 같은 결과, 0이면 파괴마다 무작위
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dataflow")
+	int32 RandomSeed = 0;
+
 	UPROPERTY(EditAnywhere, Category = "Dataflow", meta = (ClampMin = "1", ClampMax = "16"))
 	uint32 SeedNum = 1;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dataflow", meta = (ClampMin = "0.01", ClampMax = "10"))
 	float DestructionThreshold = 0.5;
 
+	// 충격 에너지 대비 이 비율 미만으로 감쇠된 버텍스에서는 에너지 전파 중단
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dataflow", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float EnergyCutoffRatio = 0.001f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dataflow")
+	ESplitMode SplitMode = ESplitMode::Exact;
+
+	// 조각을 FDynamicMesh3로 만들어 복사 없이 UDynamicMeshComponent로 넘김. 끄면 UProceduralMeshComponent 경로 사용
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dataflow")
+	bool bUseDynamicMeshOutput = true;
+
+	// 조각 충돌 볼록 껍질의 최대 정점 수
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dataflow", meta = (ClampMin = "4", ClampMax = "255"))
+	int32 MaxCollisionHullVertices = 32;
+
+	// 부피(cm³)가 각 값 미만인 조각은 구, 상자, 단순화된 볼록 껍질 충돌 사용. 그 이상은 전체 볼록 껍질
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dataflow|Collision", meta = (ClampMin = "0.0"))
+	float SphereCollisionVolume = 8.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dataflow|Collision", meta = (ClampMin = "0.0"))
+	float BoxCollisionVolume = 125.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dataflow|Collision", meta = (ClampMin = "0.0"))
+	float SimplifiedHullVolume = 1000.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dataflow|Collision", meta = (ClampMin = "4", ClampMax = "255"))
+	int32 SimplifiedHullVertices = 12;
+
+	// 조각 질량 계산에 쓰는 밀도 (g/cm³)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dataflow", meta = (ClampMin = "0.001"))
+	float FragmentDensity = 1.f;
+
+	// 소유 액터 스케일을 적용한 부피가 이 값(cm³) 미만인 영역은 가장 큰 인접 영역에 병합. 0이면 병합하지 않음
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dataflow", meta = (ClampMin = "0.0"))
+	float MinFragmentVolume = 0.f;
+
+	// 조각이 풀로 반환되기까지의 시간(초). 0이면 유지
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dataflow", meta = (ClampMin = "0.0"))
+	float FragmentLifetime = 0.f;
+
+	// 부피가 이 값(cm³) 미만인 조각은 고유 메쉬 대신 공용 청크 메쉬 인스턴스로 그림. 0이면 사용 안 함
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dataflow", meta = (ClampMin = "0.0"))
+	float DebrisVolumeThreshold = 0.f;
+
+	// 인스턴스 파편의 초기 속도 (cm/s)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dataflow", meta = (ClampMin = "0.0", EditCondition = "DebrisVolumeThreshold > 0"))
+	float DebrisSpeed = 300.f;
+
+	// 조각 생성을 여러 프레임에 나눠 프레임당 ProgressiveSpawnBudgetMs 안에서만 수행
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dataflow|Spawn")
+	bool bProgressiveSpawn = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dataflow|Spawn", meta = (ClampMin = "0.1", EditCondition = "bProgressiveSpawn"))
+	float ProgressiveSpawnBudgetMs = 2.f;
+
+	// 이 비율의 조각이 생성되면 원본 메쉬를 숨기고 조각을 드러냄. 나머지는 생성 즉시 보임
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dataflow|Spawn", meta = (ClampMin = "0.0", ClampMax = "1.0", EditCondition = "bProgressiveSpawn"))
+	float ProgressiveRevealRatio = 1.f;
+
+	// 즉시 실행 대신 UDestructionSchedulerSubsystem에 요청을 제출. 영역 계산과 분리는 워커 스레드에서, 조각 생성은 프레임 예산 안에서 실행
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dataflow")
+	bool bUseScheduler = false;
+
 	UFUNCTION(BlueprintCallable)
 	void DestructMesh(const float Energy);
 
+	// 충격을 큐에 쌓고 물리 이후 틱에서 한 번에 처리. 에너지를 합산해 DestructionThreshold 이상이면
+	// 모든 충격 지점을 시드로 한 번만 파괴 (같은 프레임의 여러 탄환/산탄용)
+	UFUNCTION(BlueprintCallable)
+	void QueueImpact(const FVector& Velocity, const FVector& NextTickVelocity, const float Mass, const FVector& HitPoint);
+
+	// 충격마다 분리 방식을 지정해 파괴
+	UFUNCTION(BlueprintCallable)
+	void DestructMeshWithMode(const float Energy, const ESplitMode Mode);
+
+	// 분리 계산을 워커 스레드에서 수행하고 조각 생성만 게임 스레드에서 처리. 블루프린트는 Destruct Mesh Async 노드 사용
+	void DestructMeshAsync(const float Energy, const ESplitMode Mode, FOnDestructionFinished OnFinished = FOnDestructionFinished());
+
+	UFUNCTION(BlueprintPure)
+	bool IsDestructionInProgress() const;
+
+	// 액터 생성 없이 파괴 계산 단계만 실행하고 조각 수 반환 (벤치마크용). 실행할 수 없으면 INDEX_NONE
+	int32 RunDestructionStages(const float Energy, const ESplitMode Mode);
+
 protected:
 	// Called when the game starts
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:	
 	// Called every frame
@@ -51,12 +182,79 @@ private:
 	UFEMCalculateComponent* FEMComponent = nullptr;
 	TArray<uint32> Seeds;
 	TArray<uint32> Region;
+	TArray<float> VertexEnergy;
+	FRandomStream SeedStream;
+
+	// 생성 대기 중인 조각. ProceduralMesh가 있으면 프로시저럴 경로
+	struct FPendingFragment
+	{
+		FFragment Fragment;
+		UProceduralMeshComponent* ProceduralMesh = nullptr;
+		double Priority = 0.0;
+	};
+
+	struct FQueuedImpact
+	{
+		FVector Velocity;
+		FVector NextTickVelocity;
+		float Mass;
+		FVector HitPoint;
+	};
+	TArray<FQueuedImpact> QueuedImpacts;
+	void ResolveQueuedImpacts();
+
+	TArray<FPendingFragment> PendingFragments;
+	TArray<TWeakObjectPtr<ASplitActor>> UnrevealedFragments;
+	int32 NumFragmentsToReveal = 0;
+	bool bFragmentsRevealed = false;
+	bool bSpawningFragments = false;
+	bool bDestructionScheduled = false;
+
+	// 프레임을 넘겨 보관하는 동안 GC되지 않도록 참조 유지
+	UPROPERTY()
+	TArray<UProceduralMeshComponent*> PendingProceduralMeshes;
+
+	UPROPERTY()
+	TArray<UMaterialInterface*> PendingMaterials;
+
+	// 비동기 파괴 한 건의 단계 간 공유 상태
+	struct FDestructionJob
+	{
+		std::atomic<bool> bCancelled{ false };
+		FFEMImpact Impact;		// 시작 시 게임 스레드에서 복사한 충격 정보
+		ESplitMode Mode = ESplitMode::Exact;
+		FDestructionQuality Quality;
+		const UStaticMesh* Mesh = nullptr;
+		FVector OwnerScale = FVector::OneVector;
+		bool bSplitOnWorker = false;	// 프로시저럴 경로는 NewObject가 필요하므로 분리를 게임 스레드에서 수행
+		TMap<uint32, DistOutEntry> DistanceMap;
+		TArray<FPendingFragment> Fragments;
+		UE::Tasks::FTask WorkerStages;
+		double RegionsMs = 0.0;		// 워커 단계 실측 시간
+		double SplitMs = 0.0;
+	};
+	TSharedPtr<FDestructionJob> ActiveJob;
+
+	// 영역 계산과 (동적 메쉬 출력이면) 분리를 워커 태스크로 시작. 완료 후 게임 스레드에서 FinishJob 호출
+	TSharedRef<FDestructionJob> LaunchWorkerStages(const float Energy, const FFEMImpact& Impact, const ESplitMode Mode, const FDestructionQuality& Quality, const UStaticMesh* Mesh);
+	// 게임 스레드 단계: 남은 분리와 조각 생성. FEM 충격 잠금 해제
+	void FinishJob(FDestructionJob& Job);
+
+	// Cancel이 설정되면 단계 사이마다 확인. 취소되어 중간에 멈추면 false
+	bool ComputeRegions(const float Energy, const FFEMImpact& Impact, const FVector& OwnerScale, TMap<uint32, DistOutEntry>& DistanceMap, const FDestructionQuality& Quality = FDestructionQuality(), const std::atomic<bool>* Cancel = nullptr);
+	void BuildPendingFragments(const TMap<uint32, DistOutEntry>* Dist, const ESplitMode Mode, const UStaticMesh* Mesh, const FVector& OwnerScale, TArray<FPendingFragment>& OutPending, const std::atomic<bool>* Cancel = nullptr) const;
+	void SpawnPendingFragments(TArray<FPendingFragment>&& Fragments);
+	ASplitActor* SpawnSplitActor();
+	ASplitActor* SpawnFragment(FPendingFragment& Entry);
+	void UpdateProgressiveSpawn();
 
-	TArray<uint32> getVoronoiSeedByRandom();
-	TArray<uint32> getVoronoiSeedByImpactPoint(const TArray<uint32> ImpactPoint);
+	TArray<uint32> getVoronoiSeedByRandom(const uint32 SeedCount);
+	TArray<uint32> getVoronoiSeedByImpactPoint(const TArray<uint32> ImpactPoint, const uint32 SeedCount);
+	TArray<uint32> getVoronoiSeedByEnergy(const uint32 SeedCount);
 	void VisualizeVertices();
-	void DestroyActor(const TMap<uint32, DistOutEntry>* Dist);
+	void DestroyActor(const TMap<uint32, DistOutEntry>* Dist, const ESplitMode Mode);
 	void UpdateGraphWeight(const float Energy, const TArray<uint32> ImpactPoint);
+	void MergeSmallRegions(TMap<uint32, DistOutEntry>& DistanceMap, const FVector& OwnerScale);
 	
 	template <typename T>
 	TArray<uint32> getRandomElementsFromArray(const TArray<T>& InputArray, uint32 NumElements)
@@ -78,7 +276,7 @@ private:
 		// �ε��� �迭�� ����
 		for (int32 i = Indices.Num() - 1; i > 0; --i)
 		{
-			int32 j = FMath::RandRange(0, i);
+			int32 j = SeedStream.RandRange(0, i);
 			Indices.Swap(i, j);
 		}
 
@@ -84,6 +84,16 @@ TArray<Link> WeightedGraph::getLinks(const uint32& index)
 	return graph[index];
 }
 
+const TArray<Link>* WeightedGraph::findLinks(const uint32& index) const
+{
+	return graph.Find(index);
+}
+
+TArray<Link>* WeightedGraph::findLinks(const uint32& index)
+{
+	return graph.Find(index);
+}
+
 bool WeightedGraph::updateLink(const uint32& FromIndex, const uint32& ToIndex, const double& LinkWeight)
 {
 	auto fromlink = getLink(FromIndex, ToIndex);
@@ -36,6 +36,11 @@ public:
 
 	TArray<Link> getLinks(const uint32& index);
 
+	// 복사 없이 인접 리스트에 직접 접근 (없으면 nullptr)
+	const TArray<Link>* findLinks(const uint32& index) const;
+
+	TArray<Link>* findLinks(const uint32& index);
+
 	bool updateLink(const uint32& FromIndex, const uint32& ToIndex, const double& LinkWeight);
 
 	const uint32 size();